@@ -161,6 +161,91 @@ typedef s32         b32;
 
 
 
+///////////////////////////////////////////////////////////////////////////////
+//
+//      Allocators
+//
+
+// Alignment of every block handed out by the arena/bump allocators
+#define MHO_ALLOC_ALIGN     16
+
+// Allocator callbacks (ctx is the allocator's user context, sizes are in bytes)
+typedef void    *(*mho_alloc_fn)(void *ctx, usize size);
+typedef void    *(*mho_realloc_fn)(void *ctx, void *ptr, usize old_size, usize new_size);
+typedef void    (*mho_free_fn)(void *ctx, void *ptr, usize size);
+
+// Generic allocator interface, used by containers that can take a custom allocator
+typedef struct _TAG_mho_allocator
+{
+    mho_alloc_fn        alloc_fn;
+    mho_realloc_fn      realloc_fn;
+    mho_free_fn         free_fn;
+    void                *ctx;
+} mho_allocator_t;
+
+// Linear arena over a single fixed-size buffer. The most recent allocation
+// can be grown/freed in place, everything else is released by a reset.
+typedef struct _TAG_mho_arena
+{
+    u8                  *base;
+    usize               capacity,
+                        used,
+                        last;       // Offset of the most recent allocation
+    b32                 owns_base;
+    mho_allocator_t     allocator;
+} mho_arena_t;
+
+// Block of memory owned by a bump allocator (data follows the struct)
+typedef struct _TAG_mho_bump_block
+{
+    struct _TAG_mho_bump_block      *next;
+    usize                           capacity,
+                                    used;
+} mho_bump_block_t;
+
+// Bump allocator over a growing chain of blocks. Individual frees are no-ops,
+// a reset rewinds to the first block in O(1) and keeps the blocks for reuse.
+typedef struct _TAG_mho_bump
+{
+    mho_bump_block_t    *first,
+                        *current;
+    usize               block_size;
+    void                *last;      // Most recent allocation
+    mho_allocator_t     allocator;
+} mho_bump_t;
+
+// Initializes an arena over buffer (or a malloc'd buffer if buffer is NULL)
+MHO_EXTERN b32              mho_arena_init(mho_arena_t *arena, void *buffer, usize capacity);
+
+// Frees the arena's buffer (if it owns it)
+MHO_EXTERN void             mho_arena_destroy(mho_arena_t *arena);
+
+// Allocates size bytes from the arena, returns NULL if it is full
+MHO_EXTERN void             *mho_arena_alloc(mho_arena_t *arena, usize size);
+
+// Releases every allocation made from the arena
+MHO_EXTERN void             mho_arena_reset(mho_arena_t *arena);
+
+// Returns the allocator interface of the arena
+MHO_EXTERN mho_allocator_t  *mho_arena_allocator(mho_arena_t *arena);
+
+// Initializes a bump allocator that grabs blocks of (at least) block_size bytes
+MHO_EXTERN void             mho_bump_init(mho_bump_t *bump, usize block_size);
+
+// Frees every block owned by the bump allocator
+MHO_EXTERN void             mho_bump_destroy(mho_bump_t *bump);
+
+// Allocates size bytes from the bump allocator
+MHO_EXTERN void             *mho_bump_alloc(mho_bump_t *bump, usize size);
+
+// Releases every allocation made from the bump allocator (O(1), keeps the blocks)
+MHO_EXTERN void             mho_bump_reset(mho_bump_t *bump);
+
+// Returns the allocator interface of the bump allocator
+MHO_EXTERN mho_allocator_t  *mho_bump_allocator(mho_bump_t *bump);
+
+
+
 ///////////////////////////////////////////////////////////////////////////////
 //
 //      Dynamic Array
@@ -170,14 +255,48 @@ typedef s32         b32;
 
 typedef struct _TAG_mho_arr_header
 {
-    u64     capacity;   // Total number of elements
-    u64     size;       // Number of elements in array containing data
+    u64                 capacity;   // Total number of elements
+    u64                 size;       // Number of elements in array containing data
+    mho_allocator_t     *allocator; // Allocator backing the array (NULL = malloc/realloc/free)
+    u32                 flags;      // MHO_ARR_*_BIT flags
+    u16                 align;      // Alignment of element 0 in bytes (0 = allocator default)
+    u16                 offset;     // Bytes from the start of the allocation to the header
 } mho_arr_header_t;
 
+// Set when the elements live in inline (stack/struct) storage that must not be freed
+#define MHO_ARR_INLINE_BIT      0x01
+
+// Smallest capacity the array will grow to when it needs more room
+#define MHO_ARR_MIN_CAPACITY    4
+
 // Wrapper macro
 #define mho_arr(__type) \
     __type *
 
+// Inline storage for a small-buffer array holding up to __n elements before it
+// spills to the heap. Use mho_sarr_init() to get an mho_arr(__type) that works
+// with every mho_arr_* macro, ie:
+//
+//      mho_sarr(u32, 16)   idx_storage;
+//      mho_arr(u32)        idx = mho_sarr_init(idx_storage);
+//
+// NOTE: The storage must not be moved/copied while the array is in use, and
+// mho_arr_free() must still be called (it is a no-op until the array spills).
+#define mho_sarr(__type, __n)           \
+    struct                              \
+    {                                   \
+        mho_arr_header_t    head;       \
+        __type              data[__n];  \
+    }
+
+// Initializes the inline storage of an mho_sarr and returns the array
+#define mho_sarr_init(__sarr) \
+    (mho__sarr_init(&(__sarr).head, sizeof((__sarr).data) / sizeof(*(__sarr).data)), (__sarr).data)
+
+// Returns whether the array still lives in its inline storage
+#define mho_arr_is_inline(__array) \
+    ((__array) != NULL && (mho_arr_head(__array)->flags & MHO_ARR_INLINE_BIT))
+
 // Returns the header of the array
 #define mho_arr_head(__array) \
     ((mho_arr_header_t *)(__array) - 1)
@@ -200,11 +319,21 @@ typedef struct _TAG_mho_arr_header
 
 // Returns whether the array is empty
 #define mho_arr_empty(__array) \
-    (mho_arr_init((void **)&(__array), sizeof(*(__array)), (mho_arr_size(__array) == 0)))
+    (mho_arr_size(__array) == 0)
 
-// Frees the array
+// Frees the array (through its allocator, if it has one)
 #define mho_arr_free(__array) \
-    (free(mho_arr_head(__array)))
+    mho__arr_free((__array), sizeof(*(__array)))
+
+// Creates an empty array with room for __cap elements, backed by __allocator
+// (which must outlive the array)
+#define mho_arr_new(__type, __cap, __allocator) \
+    ((__type *)mho__arr_create(sizeof(__type), (__cap), 0, (__allocator)))
+
+// Creates an empty array whose element 0 is aligned to __align bytes (a power
+// of two, up to 4096). The alignment is kept through every grow/shrink.
+#define mho_arr_aligned(__type, __align) \
+    ((__type *)mho__arr_create(sizeof(__type), 0, (__align), NULL))
 
 // Returns whether the array needs to grow by a given size
 #define mho_arr_need_grow(__array, __n) \
@@ -218,19 +347,27 @@ typedef struct _TAG_mho_arr_header
 #define mho_arr_grow_size(__array, __sz) \
     mho_arr_resize((__array), sizeof(*(__array)), mho_arr_capacity(__array) ? mho_arr_capacity(__array) + (__sz) : 1)
 
+// Ensures there is room for __n more elements, growing the capacity geometrically
+#define mho_arr_ensure(__array, __n) \
+    (*((void **)&(__array)) = mho__arr_ensure((__array), sizeof(*(__array)), (__n)))
+
 // Pushes data to the back of the array
-#define mho_arr_push(__array, __data)                                       \
-    do                                                                      \
-    {                                                                       \
-        mho_arr_init((void **)&(__array), sizeof(*(__array)));              \
-        if (!(__array) || ((__array) && mho_arr_need_grow(__array, 1)))     \
-        {                                                                   \
-            *((void **)&(__array)) = mho_arr_grow(__array);                 \
-        }                                                                   \
-        (__array)[mho_arr_size(__array)] = (__data);                        \
-        mho_arr_head(__array)->size++;                                      \
+#define mho_arr_push(__array, __data)                           \
+    do                                                          \
+    {                                                           \
+        if (mho_arr_need_grow(__array, 1))                      \
+            mho_arr_ensure(__array, 1);                         \
+        (__array)[mho_arr_head(__array)->size++] = (__data);    \
     } while (0)
 
+// Pushes __n elements read from __src to the back of the array
+#define mho_arr_push_n(__array, __src, __n) \
+    (*((void **)&(__array)) = mho__arr_insert_n((__array), sizeof(*(__array)), mho_arr_size(__array), (__src), (__n)))
+
+// Appends the contents of another array of the same type to the back of the array
+#define mho_arr_extend(__array, __other) \
+    mho_arr_push_n(__array, (__other), mho_arr_size(__other))
+
 // Pops data off the array (decrements the size) and returns it
 #define mho_arr_pop(__array) \
     ((mho_arr_size(__array) > 0) ? (__array)[(--mho_arr_head(__array)->size)] : (__array)[(mho_arr_head(__array)->size)])
@@ -259,33 +396,37 @@ typedef struct _TAG_mho_arr_header
 #define mho_arr_shrink(__array) \
     *((void **)&(__array)) = mho_arr_resize(__array, sizeof(*(__array)), mho_arr_size(__array));
 
-// Inserts data into the array at the specified position (0 indexing)
-// NOTE: DOES NOT WORK AT INDEX 0 (ie, cannot insert at start of array)
-#define mho_arr_insert(__array, __val, __pos)                                                       \
-    do                                                                                              \
-    {                                                                                               \
-        u32 mho__arr_iter;                                                                          \
-        if ((mho_arr_need_grow(__array, 1)))                                                        \
-            *((void **)&(__array)) = mho_arr_grow_size(__array, 1);                                 \
-        for (mho__arr_iter = mho_arr_size(__array) - 1; mho__arr_iter >= (__pos); mho__arr_iter--)  \
-        {                                                                                           \
-            (__array)[mho__arr_iter + 1] = (__array)[mho__arr_iter];                                \
-        }                                                                                           \
-        (__array)[(__pos)] = (__val);                                                               \
-        mho_arr_head(__array)->size++;                                                              \
-    } while (0);
+// Inserts data into the array at the specified position (0 indexing, a
+// position past the end is ignored)
+#define mho_arr_insert(__array, __val, __pos)                                                            \
+    do                                                                                                   \
+    {                                                                                                    \
+        if ((usize)(__pos) <= mho_arr_size(__array))                                                     \
+        {                                                                                                \
+            *((void **)&(__array)) = mho__arr_insert_n((__array), sizeof(*(__array)), (__pos), NULL, 1); \
+            (__array)[(__pos)] = (__val);                                                                \
+        }                                                                                                \
+    } while (0)
+
+// Inserts __n elements read from __src into the array at the specified position (0 indexing)
+#define mho_arr_insert_n(__array, __src, __n, __pos) \
+    (*((void **)&(__array)) = mho__arr_insert_n((__array), sizeof(*(__array)), (__pos), (__src), (__n)))
 
 // Removes data from the array at the specified position and realigns elements
-#define mho_arr_remove(__array, __pos)                                                          \
-    do                                                                                          \
-    {                                                                                           \
-        u32 mho__arr_iter;                                                                      \
-        for (mho__arr_iter = (__pos); mho__arr_iter < mho_arr_size(__array); mho__arr_iter++)   \
-        {                                                                                       \
-            (__array)[mho__arr_iter] = (__array)[mho__arr_iter + 1];                            \
-        }                                                                                       \
-        mho_arr_head(__array)->size--;                                                          \
-    } while (0);
+#define mho_arr_remove(__array, __pos) \
+    mho_arr_remove_range(__array, __pos, 1)
+
+// Removes __n elements starting at the specified position and realigns elements
+#define mho_arr_remove_range(__array, __pos, __n) \
+    mho__arr_remove_range((__array), sizeof(*(__array)), (__pos), (__n))
+
+// Removes data from the array at the specified position by moving the last
+// element into its place (O(1), does NOT preserve ordering)
+#define mho_arr_swap_remove(__array, __pos)                                     \
+    do                                                                          \
+    {                                                                           \
+        (__array)[(__pos)] = (__array)[--mho_arr_head(__array)->size];          \
+    } while (0)
 
 // Initializes the array
 local void **
@@ -303,6 +444,10 @@ mho_arr_init(void **arr,
         {
             data->size = 0;
             data->capacity = 1;
+            data->allocator = NULL;
+            data->flags = 0;
+            data->align = 0;
+            data->offset = 0;
             *arr = ((mho_arr_header_t *)data + 1);
 
             return arr;
@@ -312,38 +457,560 @@ mho_arr_init(void **arr,
     return NULL;
 }
 
+// Returns the number of bytes allocated for an array of cap elements
+#define mho__arr_bytes(__cap, __sz, __align) \
+    ((usize)(__cap) * (__sz) + sizeof(mho_arr_header_t) + ((__align) ? (usize)(__align) - 1 : 0))
+
+// Returns the offset from base at which the header must start so that the
+// elements following it land on an align boundary
+local usize
+mho__arr_offset(void *base,
+                usize align)
+{
+    usize       data;
+
+
+    data = (usize)base + sizeof(mho_arr_header_t);
+    if (align)
+        data = (data + (align - 1)) & ~(align - 1);
+
+    return data - sizeof(mho_arr_header_t) - (usize)base;
+}
+
+// Creates an empty array with room for cap elements, with element 0 aligned to
+// align bytes (0 = whatever the allocator provides)
+local void *
+mho__arr_create(usize sz,
+                usize cap,
+                usize align,
+                mho_allocator_t *allocator)
+{
+    usize                   bytes,
+                            offset;
+    u8                      *base;
+    mho_arr_header_t        *data = NULL;
+
+
+    bytes = mho__arr_bytes(cap, sz, align);
+    if (allocator)
+        base = (u8 *)allocator->alloc_fn(allocator->ctx, bytes);
+    else
+        base = (u8 *)malloc(bytes);
+
+    if (base)
+    {
+        offset = mho__arr_offset(base, align);
+        data = (mho_arr_header_t *)(base + offset);
+        data->capacity = (u64)cap;
+        data->size = 0;
+        data->allocator = allocator;
+        data->flags = 0;
+        data->align = (u16)align;
+        data->offset = (u16)offset;
+        data = (mho_arr_header_t *)data + 1;
+    }
+
+    return data;
+}
+
+// Sets up the header of an mho_sarr's inline storage
+local void
+mho__sarr_init(mho_arr_header_t *head,
+               usize capacity)
+{
+    head->capacity = (u64)capacity;
+    head->size = 0;
+    head->allocator = NULL;
+    head->flags = MHO_ARR_INLINE_BIT;
+    head->align = 0;
+    head->offset = 0;
+}
+
 // Resizes the array
 local void *
 mho_arr_resize(void *arr,
                usize sz,
                usize amt)
 {
-    usize                   capacity;
-    mho_arr_header_t        *data;
+    mho_arr_header_t        *data,
+                            *head;
+    mho_allocator_t         *allocator;
+    u8                      *base;
+    usize                   align,
+                            offset;
+    u64                     size;
 
 
-    if (arr)
-        capacity = amt;
+    if (!arr)
+        return mho__arr_create(sz, amt, 0, NULL);
+
+    head = mho_arr_head(arr);
+    allocator = head->allocator;
+    align = head->align;
+
+    // Inline storage can't shrink, and spills to the heap once it overflows
+    if (head->flags & MHO_ARR_INLINE_BIT)
+    {
+        if (amt <= head->capacity)
+            return arr;
+
+        data = (mho_arr_header_t *)mho__arr_create(sz, amt, 0, allocator);
+        if (data)
+        {
+            memcpy(data, arr, (usize)head->size * sz);
+            mho_arr_head(data)->size = head->size;
+        }
+
+        return data;
+    }
+
+    // Create new array with header + desired size
+    base = (u8 *)head - head->offset;
+    offset = head->offset;
+    size = mho_min(head->size, (u64)amt);
+    if (allocator)
+        base = (u8 *)allocator->realloc_fn(allocator->ctx, base,
+                                           mho__arr_bytes(head->capacity, sz, align),
+                                           mho__arr_bytes(amt, sz, align));
     else
-        capacity = 0;
+        base = (u8 *)realloc(base, mho__arr_bytes(amt, sz, align));
 
-    // Create new array with header + desired size (or 0 if arr is empty)
-    data = (mho_arr_header_t *)realloc(arr ? mho_arr_head(arr) : 0, capacity * sz + sizeof(mho_arr_header_t));
+    if (!base)
+        return NULL;
 
-    if (data)
+    // The new block may sit at a different alignment, so slide the header and
+    // elements over to keep element 0 on an align boundary
+    data = (mho_arr_header_t *)(base + offset);
+    if (align)
     {
-        if (!arr)
-            data->size = 0;
+        offset = mho__arr_offset(base, align);
+        if (offset != data->offset)
+        {
+            memmove(base + offset, data, sizeof(mho_arr_header_t) + (usize)size * sz);
+            data = (mho_arr_header_t *)(base + offset);
+            data->offset = (u16)offset;
+        }
+    }
 
-        data->capacity = (u32)capacity;
-        data = (mho_arr_header_t *)data + 1;
+    data->capacity = (u64)amt;
+    data->size = size;
+
+    return (mho_arr_header_t *)data + 1;
+}
+
+// Frees the array
+local void
+mho__arr_free(void *arr,
+              usize sz)
+{
+    mho_arr_header_t        *head;
+    u8                      *base;
+
+
+    if (arr && !mho_arr_is_inline(arr))
+    {
+        head = mho_arr_head(arr);
+        base = (u8 *)head - head->offset;
+        if (head->allocator)
+            head->allocator->free_fn(head->allocator->ctx, base, mho__arr_bytes(head->capacity, sz, head->align));
+        else
+            free(base);
     }
+}
 
-    return data;
+// Ensures the array can hold n more elements, doubling the capacity (or more,
+// if n is large) whenever it needs to grow
+local void *
+mho__arr_ensure(void *arr,
+                usize sz,
+                usize n)
+{
+    u64         needed,
+                capacity;
+
+
+    needed = mho_arr_size(arr) + n;
+    capacity = mho_arr_capacity(arr);
+    if (arr && needed <= capacity)
+        return arr;
+
+    capacity = mho_max(capacity * 2, needed);
+    capacity = mho_max(capacity, MHO_ARR_MIN_CAPACITY);
+
+    return mho_arr_resize(arr, sz, (usize)capacity);
+}
+
+// Opens a gap of n elements at pos (shifting the tail up with a single
+// memmove), optionally fills it from src, and bumps the size. src may point
+// into the array itself, it's rebased across the resize and the shift. A pos
+// past the end leaves the array untouched.
+local void *
+mho__arr_insert_n(void *arr,
+                  usize sz,
+                  usize pos,
+                  const void *src,
+                  usize n)
+{
+    u64         size;
+    u8          *data;
+    usize       off = 0,
+                head_len;
+    b32         aliased;
+
+
+    size = mho_arr_size(arr);
+    if (pos > size)
+        return arr;
+
+    aliased = arr && src && (const u8 *)src >= (const u8 *)arr && (const u8 *)src < (const u8 *)arr + size * sz;
+    if (aliased)
+        off = (usize)((const u8 *)src - (const u8 *)arr);
+
+    arr = mho__arr_ensure(arr, sz, n);
+    if (arr)
+    {
+        data = (u8 *)arr;
+        if (pos < size)
+            memmove(data + (pos + n) * sz, data + pos * sz, (usize)(size - pos) * sz);
+
+        if (aliased)
+        {
+            // The part of src in front of pos stayed put, the rest moved up by n
+            head_len = off < pos * sz ? mho_min(pos * sz - off, n * sz) : 0;
+            memcpy(data + pos * sz, data + off, head_len);
+            memcpy(data + pos * sz + head_len, data + off + head_len + n * sz, n * sz - head_len);
+        }
+        else if (src)
+        {
+            memcpy(data + pos * sz, src, n * sz);
+        }
+        mho_arr_head(arr)->size += n;
+    }
+
+    return arr;
+}
+
+// Removes n elements starting at pos, shifting the tail down with a single memmove
+local void
+mho__arr_remove_range(void *arr,
+                      usize sz,
+                      usize pos,
+                      usize n)
+{
+    u64         size;
+    u8          *data;
+
+
+    size = mho_arr_size(arr);
+    if (pos >= size)
+        return;
+    if (n > size - pos)
+        n = (usize)(size - pos);
+
+    data = (u8 *)arr;
+    memmove(data + pos * sz, data + (pos + n) * sz, (usize)(size - pos - n) * sz);
+    mho_arr_head(arr)->size -= n;
 }
 
 
 
+///////////////////////////////////////////////////////////////////////////////
+//
+//      Hash Map
+//
+// Open addressing with Robin Hood probing and backward-shift deletion (no
+// tombstones). Keys and values live in two flat arrays indexed by slot, next
+// to an array of per-slot hashes (0 = empty slot).
+
+// Hash function (returns a 64-bit hash of the key_size bytes at key)
+typedef u64     (*mho_map_hash_fn)(const void *key, usize key_size);
+
+// Equality function (returns TRUE if both keys are equal)
+typedef b32     (*mho_map_eq_fn)(const void *a, const void *b, usize key_size);
+
+typedef struct _TAG_mho_map_header
+{
+    u64                 capacity;   // Total number of slots (power of 2)
+    u64                 size;       // Number of slots containing data
+    u64                 slot;       // Slot found by the last lookup/insert
+    u32                 key_size,
+                        val_size;
+    u32                 *hashes;    // Hash of each slot (0 = empty)
+    mho_map_hash_fn     hash_fn;
+    mho_map_eq_fn       eq_fn;
+} mho_map_header_t;
+
+// Wrapper macro, the map is created on the first insert (so initialize it to
+// NULL). Each use declares a distinct type, so typedef it to pass maps around.
+// NOTE: Lookups write the key into tmp_key, so a map is not safe to read from
+// several threads at once.
+#define mho_map(__ktype, __vtype)       \
+    struct                              \
+    {                                   \
+        mho_map_header_t    head;       \
+        __ktype             *keys;      \
+        __vtype             *vals;      \
+        __ktype             tmp_key;    \
+        __vtype             tmp_val;    \
+    } *
+
+// Creates the map if it hasn't been created yet
+#define mho_map_init(__map)                                                                                             \
+    do                                                                                                                  \
+    {                                                                                                                   \
+        if (!(__map))                                                                                                   \
+            *((void **)&(__map)) = mho__map_create(sizeof(*(__map)), sizeof((__map)->tmp_key), sizeof((__map)->tmp_val)); \
+    } while (0)
+
+// Returns the number of entries in the map
+#define mho_map_size(__map) \
+    ((__map) == NULL ? 0 : (__map)->head.size)
+
+// Returns the number of slots in the map (for iterating with mho_map_slot_used)
+#define mho_map_capacity(__map) \
+    ((__map) == NULL ? 0 : (__map)->head.capacity)
+
+// Returns whether the given slot holds an entry ((__map)->keys/vals[__slot])
+#define mho_map_slot_used(__map, __slot) \
+    ((__map)->head.hashes[(__slot)] != 0)
+
+// Sets the hash and equality functions (before inserting anything)
+#define mho_map_set_fns(__map, __hash_fn, __eq_fn)  \
+    do                                              \
+    {                                               \
+        mho_map_init(__map);                        \
+        (__map)->head.hash_fn = (__hash_fn);        \
+        (__map)->head.eq_fn = (__eq_fn);            \
+    } while (0)
+
+// Reserves room for __amount entries without rehashing. Evaluates to FALSE
+// if the map couldn't grow.
+#define mho_map_reserve(__map, __amount)                                                                                    \
+    (((__map) || (*((void **)&(__map)) = mho__map_create(sizeof(*(__map)), sizeof((__map)->tmp_key), sizeof((__map)->tmp_val)))) ? \
+        mho__map_reserve(&(__map)->head, (void **)&(__map)->keys, (void **)&(__map)->vals, (__amount)) :                   \
+        FALSE)
+
+// Inserts a key/value pair (or overwrites the value if the key is present).
+// Evaluates to FALSE if the map couldn't grow, the pair is not inserted then.
+#define mho_map_put(__map, __key, __val)                                                                                    \
+    (((__map) || (*((void **)&(__map)) = mho__map_create(sizeof(*(__map)), sizeof((__map)->tmp_key), sizeof((__map)->tmp_val)))) ? \
+        ((__map)->tmp_key = (__key), (__map)->tmp_val = (__val),                                                            \
+         mho__map_put(&(__map)->head, (void **)&(__map)->keys, (void **)&(__map)->vals, &(__map)->tmp_key, &(__map)->tmp_val)) : \
+        FALSE)
+
+// Returns a pointer to the value of the given key (NULL if not present)
+#define mho_map_get_ptr(__map, __key)                                                           \
+    (((__map) && ((__map)->tmp_key = (__key), mho__map_find(&(__map)->head, (__map)->keys, &(__map)->tmp_key))) ? \
+        &(__map)->vals[(__map)->head.slot] : NULL)
+
+// Returns whether the map contains the given key
+#define mho_map_has(__map, __key) \
+    (mho_map_get_ptr(__map, __key) != NULL)
+
+// Removes the given key from the map (returns whether it was present)
+#define mho_map_remove(__map, __key) \
+    ((__map) ? ((__map)->tmp_key = (__key), mho__map_remove(&(__map)->head, (__map)->keys, (__map)->vals, &(__map)->tmp_key)) : FALSE)
+
+// Removes every entry from the map (keeps the capacity)
+#define mho_map_clear(__map)                \
+    do                                      \
+    {                                       \
+        if (__map)                          \
+            mho__map_clear(&(__map)->head); \
+    } while (0)
+
+// Frees the map
+#define mho_map_free(__map)                 \
+    do                                      \
+    {                                       \
+        if (__map)                          \
+            mho__map_free(&(__map)->head);  \
+    } while (0)
+
+// Default hash function (hashes the raw bytes of the key)
+MHO_EXTERN u64      mho_map_hash_bytes(const void *key, usize key_size);
+
+// Default equality function (compares the raw bytes of the key)
+MHO_EXTERN b32      mho_map_eq_bytes(const void *a, const void *b, usize key_size);
+
+// Hash function for NUL-terminated string keys (key type is char *)
+MHO_EXTERN u64      mho_map_hash_str(const void *key, usize key_size);
+
+// Equality function for NUL-terminated string keys (key type is char *)
+MHO_EXTERN b32      mho_map_eq_str(const void *a, const void *b, usize key_size);
+
+// Implementation of the map macros (don't call directly)
+MHO_EXTERN void     *mho__map_create(usize map_size, usize key_size, usize val_size);
+MHO_EXTERN b32      mho__map_reserve(mho_map_header_t *head, void **keys, void **vals, usize amount);
+MHO_EXTERN b32      mho__map_put(mho_map_header_t *head, void **keys, void **vals, void *key, void *val);
+MHO_EXTERN b32      mho__map_find(mho_map_header_t *head, void *keys, const void *key);
+MHO_EXTERN b32      mho__map_remove(mho_map_header_t *head, void *keys, void *vals, const void *key);
+MHO_EXTERN void     mho__map_clear(mho_map_header_t *head);
+MHO_EXTERN void     mho__map_free(mho_map_header_t *head);
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//      Object Pool
+//
+// Hands out 32-bit generational handles for elements that are kept densely
+// packed in an mho_arr (swap-on-delete), with a sparse slot -> dense index
+// indirection. Destroyed slots are reused through a free list, so adding and
+// removing are O(1), and stale handles are detected by their generation.
+
+// Handle to an element of a pool (0 is never a valid handle)
+typedef u32     mho_handle_t;
+
+// Number of handle bits used for the slot index (the rest is the generation)
+#ifndef MHO_POOL_INDEX_BITS
+    #define MHO_POOL_INDEX_BITS     20
+#endif // MHO_POOL_INDEX_BITS
+
+#define MHO_POOL_INDEX_MASK     ((1u << MHO_POOL_INDEX_BITS) - 1)
+#define MHO_POOL_GEN_MASK       ((1u << (32 - MHO_POOL_INDEX_BITS)) - 1)
+
+typedef struct _TAG_mho_pool_header
+{
+    mho_arr(u32)        sparse;     // Dense index of each slot (next free slot if unused)
+    mho_arr(u32)        gens;       // Current generation of each slot
+    mho_arr(u32)        handles;    // Handle of each dense element
+    u32                 free_head;  // First unused slot (U32_MAX = none)
+    u32                 found;      // Dense index found by the last lookup
+    usize               val_size;
+} mho_pool_header_t;
+
+// Wrapper macro, the pool is created on the first add (so initialize it to
+// NULL). data is an mho_arr(__type) of the live elements, with no holes.
+#define mho_pool(__type)                \
+    struct                              \
+    {                                   \
+        mho_pool_header_t   head;       \
+        mho_arr(__type)     data;       \
+        __type              tmp;        \
+    } *
+
+// Creates the pool if it hasn't been created yet
+#define mho_pool_init(__pool) \
+    ((void)((__pool) || (*((void **)&(__pool)) = mho__pool_create(sizeof(*(__pool)), sizeof((__pool)->tmp)))))
+
+// Returns the number of live elements in the pool
+#define mho_pool_size(__pool) \
+    ((__pool) == NULL ? 0 : mho_arr_size((__pool)->data))
+
+// Returns the (dense) array of live elements, for iterating
+#define mho_pool_data(__pool) \
+    ((__pool) == NULL ? NULL : (__pool)->data)
+
+// Returns the handle of the live element at the given dense index
+#define mho_pool_handle_at(__pool, __index) \
+    ((__pool)->head.handles[(__index)])
+
+// Adds an element to the pool and returns its handle (0 if the pool is full)
+#define mho_pool_add(__pool, __val) \
+    (mho_pool_init(__pool), (__pool)->tmp = (__val), mho__pool_add(&(__pool)->head, (void **)&(__pool)->data, &(__pool)->tmp))
+
+// Returns a pointer to the element of the given handle (NULL if it is stale)
+#define mho_pool_get(__pool, __handle) \
+    (((__pool) && mho__pool_find(&(__pool)->head, (__handle))) ? &(__pool)->data[(__pool)->head.found] : NULL)
+
+// Returns whether the handle refers to a live element
+#define mho_pool_valid(__pool, __handle) \
+    ((__pool) != NULL && mho__pool_find(&(__pool)->head, (__handle)))
+
+// Removes the element of the given handle (returns whether it was live). The
+// last element is moved into its place, so dense indices are not stable.
+#define mho_pool_remove(__pool, __handle) \
+    ((__pool) ? mho__pool_remove(&(__pool)->head, (__pool)->data, (__handle)) : FALSE)
+
+// Removes every element from the pool (invalidates every handle)
+#define mho_pool_clear(__pool)                                  \
+    do                                                          \
+    {                                                           \
+        if (__pool)                                             \
+            mho__pool_clear(&(__pool)->head, (__pool)->data);   \
+    } while (0)
+
+// Frees the pool
+#define mho_pool_free(__pool)                                   \
+    do                                                          \
+    {                                                           \
+        if (__pool)                                             \
+            mho__pool_free(&(__pool)->head, (__pool)->data);    \
+    } while (0)
+
+// Implementation of the pool macros (don't call directly)
+MHO_EXTERN void             *mho__pool_create(usize pool_size, usize val_size);
+MHO_EXTERN mho_handle_t     mho__pool_add(mho_pool_header_t *head, void **data, const void *val);
+MHO_EXTERN b32              mho__pool_find(mho_pool_header_t *head, mho_handle_t handle);
+MHO_EXTERN b32              mho__pool_remove(mho_pool_header_t *head, void *data, mho_handle_t handle);
+MHO_EXTERN void             mho__pool_clear(mho_pool_header_t *head, void *data);
+MHO_EXTERN void             mho__pool_free(mho_pool_header_t *head, void *data);
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//      Ring Buffers
+//
+// Fixed-capacity (power of 2) lock-free queues of elem_size byte elements.
+// The SPSC queue is wait-free for one producer and one consumer thread, the
+// MPMC queue uses per-cell sequence numbers (Vyukov) for any number of either.
+// The bulk variants move up to n elements at once and return how many moved.
+// Uses C11 atomics, or the Interlocked intrinsics with MSVC.
+
+// Size of a cache line, used to pad the producer/consumer indices apart
+#ifndef MHO_CACHE_LINE
+    #define MHO_CACHE_LINE      64
+#endif // MHO_CACHE_LINE
+
+typedef struct _TAG_mho_spsc    mho_spsc_t;
+typedef struct _TAG_mho_mpmc    mho_mpmc_t;
+
+// Creates an SPSC queue holding capacity elements (rounded up to a power of 2)
+MHO_EXTERN mho_spsc_t   *mho_spsc_create(usize elem_size, usize capacity);
+
+// Destroys an SPSC queue
+MHO_EXTERN void         mho_spsc_destroy(mho_spsc_t *queue);
+
+// Pushes an element (producer thread only), returns FALSE if the queue is full
+MHO_EXTERN b32          mho_spsc_push(mho_spsc_t *queue, const void *elem);
+
+// Pops an element (consumer thread only), returns FALSE if the queue is empty
+MHO_EXTERN b32          mho_spsc_pop(mho_spsc_t *queue, void *elem);
+
+// Pushes up to n elements (producer thread only)
+MHO_EXTERN usize        mho_spsc_push_n(mho_spsc_t *queue, const void *elems, usize n);
+
+// Pops up to n elements (consumer thread only)
+MHO_EXTERN usize        mho_spsc_pop_n(mho_spsc_t *queue, void *elems, usize n);
+
+// Returns the number of elements in the queue (a snapshot, if other threads are using it)
+MHO_EXTERN usize        mho_spsc_size(mho_spsc_t *queue);
+
+// Creates an MPMC queue holding capacity elements (rounded up to a power of 2)
+MHO_EXTERN mho_mpmc_t   *mho_mpmc_create(usize elem_size, usize capacity);
+
+// Destroys an MPMC queue
+MHO_EXTERN void         mho_mpmc_destroy(mho_mpmc_t *queue);
+
+// Pushes an element, returns FALSE if the queue is full
+MHO_EXTERN b32          mho_mpmc_push(mho_mpmc_t *queue, const void *elem);
+
+// Pops an element, returns FALSE if the queue is empty
+MHO_EXTERN b32          mho_mpmc_pop(mho_mpmc_t *queue, void *elem);
+
+// Pushes up to n elements, claiming contiguous cells with a single CAS
+MHO_EXTERN usize        mho_mpmc_push_n(mho_mpmc_t *queue, const void *elems, usize n);
+
+// Pops up to n elements, claiming contiguous cells with a single CAS
+MHO_EXTERN usize        mho_mpmc_pop_n(mho_mpmc_t *queue, void *elems, usize n);
+
+// Returns the number of elements in the queue (a snapshot, if other threads are using it)
+MHO_EXTERN usize        mho_mpmc_size(mho_mpmc_t *queue);
+
+
+
 ///////////////////////////////////////////////////////////////////////////////
 //
 //      Util
@@ -360,15 +1027,32 @@ MHO_EXTERN b32      mho_file_write(const char *filename, char *buffer, usize byt
 // Appends the contents of a char * buffer into a file, given a filename
 MHO_EXTERN b32      mho_file_append(const char *filename, char *buffer, usize byte_cnt);
 
-// Returns the length of a file, given a filename
-MHO_EXTERN long     mho_file_len(const char *filename);
+// Returns the length of a file (-1 on failure), given a filename
+MHO_EXTERN s64      mho_file_len(const char *filename);
 
 // Returns the number of lines in a file, given a filename
-MHO_EXTERN u32      mho_file_lines(const char *filename);
+MHO_EXTERN u64      mho_file_lines(const char *filename);
+
+// Reads a whole file into a caller-provided buffer without allocating. If the
+// file doesn't fit, returns FALSE with len set to the size it needs (or 0 if
+// that can't be known up front, ie for pipes).
+MHO_EXTERN b32      mho_file_read_into(const char *filename, void *buffer, usize capacity, usize *len);
+
+// Reads a whole file into a reusable array (resized to the file length, and
+// NULL-terminated past the end). The array only ever grows, so re-reading
+// files into the same one stops allocating once it's big enough. The array
+// is kept (not freed) when the read fails.
+MHO_EXTERN b32      mho_file_read_arr(const char *filename, mho_arr(char) *buffer);
+
+// Returns the byte offset of the start of every line in a file, given a
+// filename (line i spans index[i] up to index[i + 1] or the end of the file)
+MHO_EXTERN mho_arr(u64) mho_file_line_index(const char *filename);
 
 //--------------- FILE * ------------------//
 
-// Reads a file and writes it into a char * buffer, given a FILE * handle
+// Reads byte_cnt bytes from the current position of a FILE * handle into a
+// NULL-terminated buffer, or the whole file (from the start, for regular files
+// only) if byte_cnt is 0. The position is restored afterwards.
 MHO_EXTERN char     *mho_file_readf(FILE *file, usize byte_cnt);
 
 // Writes the contents of a char * buffer into a file, given a FILE * handle
@@ -377,21 +1061,476 @@ MHO_EXTERN b32      mho_file_writef(FILE *file, char *buffer, usize byte_cnt);
 // Appends the contents of a char * buffer into a file, given a FILE * handle
 MHO_EXTERN b32      mho_file_appendf(FILE *file, char *buffer, usize byte_cnt);
 
-// Returns the length of a file given a FILE * handle
-MHO_EXTERN long     mho_file_lenf(FILE *fp);
+// Returns the length of a file (-1 on failure), given a FILE * handle
+MHO_EXTERN s64      mho_file_lenf(FILE *fp);
 
 // Returns the number of lines in a file, given a FILE * handle
-MHO_EXTERN u32      mho_file_linesf(FILE *file);
+MHO_EXTERN u64      mho_file_linesf(FILE *file);
+
+
+//--------------- MAPPED FILES ------------------//
+
+// Access hints for mho_file_map (OR'd together)
+#define MHO_FMAP_SEQUENTIAL     0x01    // The file will be read front to back
+#define MHO_FMAP_RANDOM         0x02    // The file will be read in random order
+#define MHO_FMAP_WILLNEED       0x04    // Start reading the file in right away
+#define MHO_FMAP_HUGEPAGE       0x08    // Back the mapping with huge pages if possible
+
+// Read-only view of a file
+typedef struct _TAG_mho_fmap
+{
+    const u8        *data;
+    u64             len;
+    b32             mapped;     // FALSE if the file was read into a heap buffer instead
+    void            *handle;    // Mapping handle (Windows only)
+} mho_fmap_t;
+
+// Maps a file into memory read-only (zero-copy). Non-regular files (pipes,
+// devices, ...) fall back to being read into a heap buffer.
+MHO_EXTERN b32      mho_file_map(const char *filename, u32 hints, mho_fmap_t *map);
+
+// Unmaps (or frees) a file mapped with mho_file_map
+MHO_EXTERN void     mho_file_unmap(mho_fmap_t *map);
+
+
+//--------------- PACK FILES ------------------//
+
+// Container of typed arrays that loads in place: a header, a table of
+// sections, then each section's data on a 64-byte boundary. Opening a pack
+// maps it and hands out pointers straight into the mapping.
+
+#define MHO_PACK_ALIGN      64
+
+// Element type tags of pack sections
+#define MHO_PACK_RAW        0       // Opaque elements of any size
+#define MHO_PACK_U8         1
+#define MHO_PACK_U16        2
+#define MHO_PACK_U32        3
+#define MHO_PACK_U64        4
+#define MHO_PACK_S32        5
+#define MHO_PACK_F32        6
+#define MHO_PACK_F64        7
+#define MHO_PACK_VEC2       8       // mho_vec2_t
+#define MHO_PACK_VEC3       9       // mho_vec3_t
+#define MHO_PACK_VEC4       10      // mho_vec4_t
+#define MHO_PACK_MAT4       11      // mho_mat4_t
+#define MHO_PACK_QUAT       12      // mho_quat_t
+
+// File header (padded to MHO_PACK_ALIGN bytes)
+typedef struct _TAG_mho_pack_header
+{
+    u32             magic,
+                    version,
+                    section_cnt,
+                    table_checksum;     // CRC32C of the section table
+    u64             file_size;
+    u8              reserved[40];
+} mho_pack_header_t;
+
+// Section table entry
+typedef struct _TAG_mho_pack_section
+{
+    u32             id,                 // User-chosen tag to look the section up by
+                    type,               // MHO_PACK_* element type
+                    elem_size,
+                    checksum;           // CRC32C of the data
+    u64             offset,             // From the start of the file
+                    count;
+} mho_pack_section_t;
+
+// Input of mho_pack_write
+typedef struct _TAG_mho_pack_input
+{
+    u32             id,
+                    type,
+                    elem_size;
+    const void      *data;
+    u64             count;
+} mho_pack_input_t;
+
+// An open pack file
+typedef struct _TAG_mho_pack
+{
+    mho_fmap_t                  map;
+    const mho_pack_header_t     *header;
+    const mho_pack_section_t    *sections;
+} mho_pack_t;
+
+// Describes an mho_arr as a pack section
+#define mho_pack_arr(__id, __type, __array) \
+    ((mho_pack_input_t){ (__id), (__type), sizeof(*(__array)), (__array), mho_arr_size(__array) })
+
+// Gets a typed pointer to the section with the given id (NULL if it's missing
+// or holds a different type)
+#define mho_pack_get_as(__pack, __id, __tag, __type, __count) \
+    ((const __type *)mho_pack_get((__pack), (__id), (__tag), (__count)))
+
+// Writes count sections to a pack file
+MHO_EXTERN b32          mho_pack_write(const char *filename, const mho_pack_input_t *inputs, u32 count);
+
+// Maps a pack file and validates its header and section table. With verify,
+// every section's checksum is checked too (which touches all of the data).
+MHO_EXTERN b32          mho_pack_open(const char *filename, b32 verify, mho_pack_t *pack);
+
+// Unmaps a pack file, invalidating every pointer into it
+MHO_EXTERN void         mho_pack_close(mho_pack_t *pack);
+
+// Gets the data of the section with the given id, checking its type tag, and
+// its element count. Points into the mapping (no copy).
+MHO_EXTERN const void   *mho_pack_get(mho_pack_t *pack, u32 id, u32 type, u64 *count);
+
+
+//--------------- FILE CACHE ------------------//
+
+// Reference-counted cache of file contents, keyed by path and validated
+// against the file's size and modification time on every lookup. Unused
+// files are evicted LRU-first once the cache goes over its byte budget.
+typedef struct _TAG_mho_fcache mho_fcache_t;
+
+// Counters of a file cache
+typedef struct _TAG_mho_fcache_stats
+{
+    u64             hits,
+                    misses,
+                    evictions,
+                    bytes,          // Bytes of file data held
+                    entries;
+} mho_fcache_stats_t;
+
+// Creates a file cache holding (roughly) at most budget bytes of unused files
+MHO_EXTERN mho_fcache_t *mho_fcache_create(u64 budget);
+
+// Destroys a file cache (every file must have been released)
+MHO_EXTERN void         mho_fcache_destroy(mho_fcache_t *cache);
+
+// Gets the contents of a file (NULL-terminated), loading it on a miss. Each
+// call takes a reference that must be given back with mho_fcache_release.
+MHO_EXTERN const char   *mho_fcache_get(mho_fcache_t *cache, const char *filename, u64 *len);
+
+// Releases a reference taken by mho_fcache_get
+MHO_EXTERN void         mho_fcache_release(mho_fcache_t *cache, const char *data);
+
+// Gets the counters of a file cache
+MHO_EXTERN void         mho_fcache_stats(mho_fcache_t *cache, mho_fcache_stats_t *stats);
+
+
+//--------------- STREAMING ------------------//
+
+// Reads a file as a series of fixed-size chunks. A background thread keeps up
+// to depth chunks read ahead, so I/O overlaps with processing and memory use
+// is bounded by chunk_size * depth rather than the file size.
+typedef struct _TAG_mho_stream mho_stream_t;
+
+// Throughput statistics for a stream
+typedef struct _TAG_mho_stream_stats
+{
+    u64         bytes;          // Bytes handed out so far
+    u64         chunks;         // Chunks handed out so far
+    f64         elapsed;        // Seconds since the stream was opened
+    f64         stall;          // Seconds spent waiting on the reader thread
+    f64         io;             // Seconds the reader thread spent reading
+    f64         throughput;     // bytes / elapsed
+} mho_stream_stats_t;
+
+// Opens a stream (chunk_size 0 = 1 MiB, depth is clamped to at least 2)
+MHO_EXTERN mho_stream_t *mho_stream_open(const char *filename, usize chunk_size, u32 depth);
+
+// Gets the next chunk, returning FALSE at the end of the file. The chunk
+// stays valid until the next call.
+MHO_EXTERN b32      mho_stream_next(mho_stream_t *stream, const u8 **data, usize *len);
+
+// Returns whether the stream ended because of a read error
+MHO_EXTERN b32      mho_stream_error(mho_stream_t *stream);
+
+// Gets the throughput statistics of a stream
+MHO_EXTERN void     mho_stream_stats(mho_stream_t *stream, mho_stream_stats_t *stats);
+
+// Stops the reader thread and closes the stream
+MHO_EXTERN void     mho_stream_close(mho_stream_t *stream);
+
+
+//--------------- PARALLEL READS ------------------//
+
+// Reads a whole file into a malloc'd, NULL-terminated buffer like
+// mho_file_read. Files of 64 MiB and up are split into ranges that are read
+// concurrently on up to thread_cnt threads (0 = pick from the core count).
+MHO_EXTERN char     *mho_file_read_parallel(const char *filename, u32 thread_cnt, u64 *len);
+
+
+// Per-file error codes of a batched read
+#define MHO_FILE_OK             0
+#define MHO_FILE_ERR_OPEN       1       // The file doesn't exist or couldn't be opened
+#define MHO_FILE_ERR_READ       2       // Reading the file failed
+
+// Contents of one file in a batch (data is NULL-terminated, like mho_file_read)
+typedef struct _TAG_mho_file_span
+{
+    char            *data;
+    u64             len;
+    s32             error;
+} mho_file_span_t;
+
+// Result of mho_file_read_many. Every file lives in the one arena.
+typedef struct _TAG_mho_file_batch
+{
+    mho_arena_t     arena;
+    mho_file_span_t *spans;     // One per filename, in the same order
+    u32             count,
+                    failed;     // Number of spans with an error
+} mho_file_batch_t;
+
+// Reads many files concurrently on a pool of threads (thread_cnt 0 = pick
+// from the core count). Returns FALSE only if memory ran out, per-file
+// failures are reported in the spans.
+MHO_EXTERN b32      mho_file_read_many(const char **filenames, u32 count, u32 thread_cnt, mho_file_batch_t *batch);
+
+// Frees the spans and arena of a batch
+MHO_EXTERN void     mho_file_batch_free(mho_file_batch_t *batch);
+
+
+//--------------- COMPRESSION ------------------//
+
+// Size of the independently decodable blocks in a compressed file
+#define MHO_LZ_BLOCK_SIZE       (256 * 1024)
+
+// Returns the worst-case compressed size of len bytes
+MHO_EXTERN usize    mho_lz_bound(usize len);
+
+// Compresses a buffer (LZ4-style byte-aligned LZ77), returns the compressed
+// size or 0 if it doesn't fit in capacity bytes
+MHO_EXTERN usize    mho_lz_compress(const void *src, usize len, void *dst, usize capacity);
+
+// Decompresses a buffer, returns the decompressed size or -1 if the data is
+// malformed or doesn't fit in capacity bytes
+MHO_EXTERN s64      mho_lz_decompress(const void *src, usize len, void *dst, usize capacity);
+
+// Compresses a buffer into a file of framed blocks, on up to thread_cnt
+// threads (0 = one per core). shuffle is the element size of the byte-shuffle
+// filter (ie 4 for f32 data, which compresses much better shuffled), 0 = off.
+MHO_EXTERN b32      mho_file_write_compressed(const char *filename, const void *buffer, u64 byte_cnt, u32 shuffle, u32 thread_cnt);
+
+// Reads a file written by mho_file_write_compressed into a malloc'd,
+// NULL-terminated buffer, decoding the blocks on up to thread_cnt threads
+MHO_EXTERN char     *mho_file_read_compressed(const char *filename, u32 thread_cnt, u64 *len);
+
+
+//--------------- HASHING ------------------//
+
+// Incremental state of mho_hash (feed it with mho_hash_update, in any
+// chunking, and mho_hash_final gives the same value as a single mho_hash)
+typedef struct _TAG_mho_hash_state
+{
+    u64             acc[8];
+    u64             key[16];
+    u64             total_len;
+    u32             buffer_len,
+                    stripe_cnt;     // Stripes consumed in the current block
+    u8              buffer[64];
+} mho_hash_state_t;
+
+// 64-bit non-cryptographic hash of len bytes. Not stable across library
+// versions, so don't store it in files.
+MHO_EXTERN u64      mho_hash(const void *data, usize len, u64 seed);
+MHO_EXTERN void     mho_hash_init(mho_hash_state_t *state, u64 seed);
+MHO_EXTERN void     mho_hash_update(mho_hash_state_t *state, const void *data, usize len);
+MHO_EXTERN u64      mho_hash_final(const mho_hash_state_t *state);
+
+// CRC32C (Castagnoli) checksum, SSE4.2 accelerated where available. Pass 0
+// to start, or a previous result to continue it over the next chunk.
+MHO_EXTERN u32      mho_crc32c(u32 crc, const void *data, usize len);
+
+//--------------- SORTING ------------------//
+
+// NOTE: The sorts below are LSD radix sorts (stable). scratch is an mho_arr(u8)
+// that holds the temporary buffers, so it can be reused across calls to avoid
+// allocating each time (pass NULL to use a temporary one). Key-value variants
+// permute n values of val_size bytes along with the keys (n must fit in a u32).
+
+// Sorts an array of u32 keys in place
+MHO_EXTERN void     mho_sort_u32(u32 *keys, usize n, mho_arr(u8) *scratch);
+
+// Sorts an array of u64 keys in place
+MHO_EXTERN void     mho_sort_u64(u64 *keys, usize n, mho_arr(u8) *scratch);
+
+// Sorts an array of f32 keys in place (-0.0 sorts before +0.0, NaNs go to the ends)
+MHO_EXTERN void     mho_sort_f32(f32 *keys, usize n, mho_arr(u8) *scratch);
+
+// Sorts an array of u32 keys and its values in place
+MHO_EXTERN void     mho_sort_u32_kv(u32 *keys, void *vals, usize val_size, usize n, mho_arr(u8) *scratch);
+
+// Sorts an array of u64 keys and its values in place
+MHO_EXTERN void     mho_sort_u64_kv(u64 *keys, void *vals, usize val_size, usize n, mho_arr(u8) *scratch);
+
+// Sorts an array of f32 keys and its values in place
+MHO_EXTERN void     mho_sort_f32_kv(f32 *keys, void *vals, usize val_size, usize n, mho_arr(u8) *scratch);
+
+// Sorts n items of item_size bytes in place by the u32 key returned by key_fn (ie, an ID field)
+MHO_EXTERN void     mho_sort_by_u32(void *items, usize item_size, usize n, u32 (*key_fn)(const void *item), mho_arr(u8) *scratch);
+
+// Sorts n items of item_size bytes in place by the f32 key returned by key_fn (ie, a depth for mho_vec3_t)
+MHO_EXTERN void     mho_sort_by_f32(void *items, usize item_size, usize n, f32 (*key_fn)(const void *item), mho_arr(u8) *scratch);
+
+// Returns the index of the first key >= key in a sorted array (n if there is none)
+MHO_EXTERN usize    mho_lower_bound_u32(const u32 *keys, usize n, u32 key);
+MHO_EXTERN usize    mho_lower_bound_u64(const u64 *keys, usize n, u64 key);
+MHO_EXTERN usize    mho_lower_bound_f32(const f32 *keys, usize n, f32 key);
+
+// Returns the index of the first key > key in a sorted array (n if there is none)
+MHO_EXTERN usize    mho_upper_bound_u32(const u32 *keys, usize n, u32 key);
+MHO_EXTERN usize    mho_upper_bound_u64(const u64 *keys, usize n, u64 key);
+MHO_EXTERN usize    mho_upper_bound_f32(const f32 *keys, usize n, f32 key);
+
+
+//--------------- STRINGS ------------------//
+
+// Non-owning string slice (not necessarily NUL-terminated)
+typedef struct _TAG_mho_str
+{
+    const char      *ptr;
+    usize           len;
+} mho_str_t;
+
+// Growable, NUL-terminated string builder. It can start out on caller-provided
+// storage, and only allocates if it outgrows it.
+typedef struct _TAG_mho_strbuf
+{
+    char            *ptr;
+    usize           len,
+                    cap;        // Bytes available for characters (excluding the NUL)
+    b32             owns_ptr;   // FALSE while ptr is caller-provided storage
+} mho_strbuf_t;
+
+// Makes a slice out of a string literal (no strlen)
+#define mho_str_lit(__lit) \
+    mho_str_n((__lit), sizeof(__lit) - 1)
+
+// Makes a slice out of a NUL-terminated string
+MHO_EXTERN mho_str_t    mho_str(const char *cstr);
+
+// Makes a slice out of a pointer and a length
+MHO_EXTERN mho_str_t    mho_str_n(const char *ptr, usize len);
+
+// Returns the sub-slice [pos, pos + len) of a slice (clamped to its bounds)
+MHO_EXTERN mho_str_t    mho_str_sub(mho_str_t str, usize pos, usize len);
+
+// Returns whether two slices have the same contents
+MHO_EXTERN b32          mho_str_eq(mho_str_t a, mho_str_t b);
+
+// Returns whether a slice starts with prefix
+MHO_EXTERN b32          mho_str_starts_with(mho_str_t str, mho_str_t prefix);
+
+// Initializes a builder on storage of size bytes (pass NULL/0 to start on the heap)
+MHO_EXTERN void         mho_strbuf_init(mho_strbuf_t *sb, char *storage, usize size);
+
+// Frees the builder's heap storage (if it has any)
+MHO_EXTERN void         mho_strbuf_free(mho_strbuf_t *sb);
+
+// Makes room for n more characters, returns FALSE if the allocation failed
+MHO_EXTERN b32          mho_strbuf_reserve(mho_strbuf_t *sb, usize n);
+
+// Empties the builder (keeps the storage)
+MHO_EXTERN void         mho_strbuf_clear(mho_strbuf_t *sb);
+
+// Appends a slice to the builder
+MHO_EXTERN b32          mho_strbuf_append(mho_strbuf_t *sb, mho_str_t str);
+
+// Appends a NUL-terminated string to the builder
+MHO_EXTERN b32          mho_strbuf_append_cstr(mho_strbuf_t *sb, const char *cstr);
+
+// Appends a character to the builder
+MHO_EXTERN b32          mho_strbuf_append_char(mho_strbuf_t *sb, char c);
+
+// Appends printf-style formatted text to the builder
+MHO_EXTERN b32          mho_strbuf_appendf(mho_strbuf_t *sb, const char *fmt, ...);
+
+// Returns the builder's contents as a slice
+MHO_EXTERN mho_str_t    mho_strbuf_str(const mho_strbuf_t *sb);
+
+
+//--------------- NUMBERS ------------------//
+
+// Buffer size that holds any number formatted below (and its NULL)
+#define MHO_NUM_STR_MAX     32
+
+// Parses a float (strtod syntax, hex floats and inf/nan included) at *str,
+// reading no further than end, and advances *str past it. Correctly rounded.
+// Unlike strtod, leading whitespace is not skipped. Returns FALSE if there is
+// no number at *str.
+MHO_EXTERN b32      mho_parse_f64(const char **str, const char *end, f64 *out);
+MHO_EXTERN b32      mho_parse_f32(const char **str, const char *end, f32 *out);
+
+// Writes the shortest decimal string that parses back to val, returns its
+// length (the buffer needs MHO_NUM_STR_MAX bytes)
+MHO_EXTERN u32      mho_f64_to_str(f64 val, char *buf);
+MHO_EXTERN u32      mho_f32_to_str(f32 val, char *buf);
+
+// Writes val in decimal, returns its length
+MHO_EXTERN u32      mho_u64_to_str(u64 val, char *buf);
+MHO_EXTERN u32      mho_s64_to_str(s64 val, char *buf);
+
+
+//--------------- INTERNING ------------------//
+
+// String intern table, maps strings to stable 32-bit IDs (0 = no string). The
+// strings are copied into bump-allocated blocks and never move. Any number of
+// threads can look strings up at once (inserts take a write lock).
+typedef struct _TAG_mho_intern  mho_intern_t;
+
+// Creates an intern table
+MHO_EXTERN mho_intern_t     *mho_intern_create(void);
+
+// Destroys an intern table (and every string in it)
+MHO_EXTERN void             mho_intern_destroy(mho_intern_t *table);
+
+// Returns the ID of a NUL-terminated string, adding it if needed
+MHO_EXTERN u32              mho_intern(mho_intern_t *table, const char *str);
+
+// Returns the ID of a string of len bytes, adding it if needed
+MHO_EXTERN u32              mho_intern_n(mho_intern_t *table, const char *str, usize len);
+
+// Returns the ID of a string of len bytes, or 0 if it hasn't been added
+MHO_EXTERN u32              mho_intern_find(mho_intern_t *table, const char *str, usize len);
+
+// Returns the (NUL-terminated) string of an ID ("" for 0/unknown IDs)
+MHO_EXTERN const char       *mho_intern_str(mho_intern_t *table, u32 id);
+
+// Returns the length of the string of an ID
+MHO_EXTERN usize            mho_intern_len(mho_intern_t *table, u32 id);
+
+// Returns the number of strings in the table
+MHO_EXTERN u32              mho_intern_count(mho_intern_t *table);
 
 
 //--------------- STDLIB ------------------//
+
+// Instruction set extensions reported by mho_cpu_features
+#define MHO_CPU_SSE2        0x01
+#define MHO_CPU_SSE42       0x02
+#define MHO_CPU_AVX2        0x04
+#define MHO_CPU_AVX512      0x08    // AVX-512 F + BW
+
+// Returns the MHO_CPU_* extensions usable on this machine (detected once
+// through cpuid, the vectorized routines below dispatch on it)
+MHO_EXTERN u32      mho_cpu_features(void);
+
 MHO_EXTERN void     mho_memcpy(void *dest, void *src, usize n);
+// Splits copies of 64 MiB and up across up to thread_cnt threads (0 = pick
+// from the core count). Stores bypass the cache, so dest isn't left in it.
+MHO_EXTERN void     mho_memcpy_parallel(void *dest, void *src, usize n, u32 thread_cnt);
 MHO_EXTERN void     *mho_memset(void *dest, s32 c, usize n);
 MHO_EXTERN void     mho_strcpy(s8 *dest, s8 *src);
 MHO_EXTERN void     mho_strncpy(s8 *dest, s8 *src, usize n);
-MHO_EXTERN usize    mho_strlen(s8 *str);
 MHO_EXTERN s8       *mho_strcat(s8 *str1, s8 *str2);
 
+// Vectorized scans. They never read across a page the string does not
+// reach, so they are safe right up to the end of a mapping.
+MHO_EXTERN usize    mho_strlen(s8 *str);
+MHO_EXTERN s8       *mho_strchr(const s8 *str, s32 c);
+MHO_EXTERN void     *mho_memchr(const void *ptr, s32 c, usize n);
+// Returns the first occurrence of needle, or NULL if there is none
+MHO_EXTERN void     *mho_memmem(const void *hay, usize hay_len, const void *needle, usize needle_len);
+MHO_EXTERN s8       *mho_strstr(const s8 *hay, const s8 *needle);
+
 
 ///////////////////////////////////////////////////////////////////////////////
 //
@@ -726,6 +1865,60 @@ MHO_EXTERN f32      mho_fsqrtinv(f32 number);
 
 
 
+///////////////////////////////////////////////////////////////////////////////
+//
+//      Mesh Loading
+//
+
+// Index used for a missing uv/normal in a face corner
+#define MHO_OBJ_NONE        0xFFFFFFFF
+
+// Corner of a triangle (0-based indices into the positions/uvs/normals)
+typedef struct _TAG_mho_obj_index
+{
+    u32                         v,
+                                vt,
+                                vn;
+} mho_obj_index_t;
+
+// Contents of a Wavefront OBJ file
+typedef struct _TAG_mho_obj
+{
+    mho_arr(mho_vec3_t)         positions;
+    mho_arr(mho_vec2_t)         uvs;
+    mho_arr(mho_vec3_t)         normals;
+    mho_arr(mho_obj_index_t)    indices;    // 3 per triangle (polygons are fan-triangulated)
+} mho_obj_t;
+
+// Loads the v/vt/vn/f records of an OBJ file (everything else is skipped),
+// parsing chunks of it on up to thread_cnt threads (0 = one per core)
+MHO_EXTERN b32                  mho_obj_load(const char *filename, u32 thread_cnt, mho_obj_t *obj);
+
+// Frees the arrays of a loaded OBJ file
+MHO_EXTERN void                 mho_obj_free(mho_obj_t *obj);
+
+// Loads a file of whitespace or comma separated floats (lines starting with
+// '#' are skipped), parsing chunks of it on up to thread_cnt threads
+MHO_EXTERN mho_arr(f32)         mho_file_read_floats(const char *filename, u32 thread_cnt);
+
+// Loads a file of 2 float columns (the float count must be a multiple of 2)
+MHO_EXTERN mho_arr(mho_vec2_t)  mho_file_read_vec2(const char *filename, u32 thread_cnt);
+
+// Loads a file of 3 float columns (the float count must be a multiple of 3)
+MHO_EXTERN mho_arr(mho_vec3_t)  mho_file_read_vec3(const char *filename, u32 thread_cnt);
+
+// Writes row_cnt rows of col_cnt comma separated floats, formatting chunks
+// of rows on up to thread_cnt threads (0 = one per core)
+MHO_EXTERN b32                  mho_csv_write_f32(const char *filename, const f32 *data, u64 row_cnt, u32 col_cnt, u32 thread_cnt);
+
+// Writes an mho_arr of an f32 based type (mho_vec2_t ... mho_mat4_t) as CSV,
+// one element per row (matrices in their column-major element order)
+#define mho_csv_write_arr(__filename, __array, __thread_cnt)                            \
+    mho_csv_write_f32((__filename), (const f32 *)(__array), mho_arr_size(__array),     \
+                      (u32)(sizeof(*(__array)) / sizeof(f32)), (__thread_cnt))
+
+
+
 ///////////////////////////////////////////////////////////////////////////////
 //
 //      Debugging
@@ -32,6 +32,23 @@ global u32                  mho_fopen_cnt;
 global u32                  mho_fclose_cnt;
 global mho_dbg_mrec_t   *mho_dbg_mhead = NULL;
 
+// Copies a string the caller may not keep alive (the fopen filename). Source
+// tags are __FILE__ literals and are stored as is.
+internal char *
+mho_dbg_strdup(const char *str)
+{
+    char        *copy;
+    usize       len;
+
+
+    len = strlen(str) + 1;
+    copy = (char *)malloc(len);
+    if (copy)
+        memcpy(copy, str, len);
+
+    return copy;
+}
+
 void *
 mho_dbg_malloc(size_t size,
                char *file,
@@ -203,7 +220,7 @@ typedef struct _TAG_mho_dbg_frec
 {
     FILE                            *fptr;
     char                            *file,
-                                    *filename,
+                                    *filename,      // Owned copy
                                     *mode;
     int                             line;
     byte                            flags;
@@ -267,7 +284,7 @@ mho_dbg_file_rec_append(FILE *fptr,
 
     new_node = (mho_dbg_frec_t *)malloc(sizeof(mho_dbg_frec_t));
     new_node->fptr = fptr;
-    new_node->filename = filename;
+    new_node->filename = mho_dbg_strdup(filename);
     new_node->file = file;
     new_node->line = line;
     new_node->flags = 0x0;
@@ -414,17 +414,22 @@ mho_mat4_translate_remove(mho_mat4_t matrix)
 void
 mho_mat4_print(mho_mat4_t matrix)
 {
+    char    line[4 * MHO_NUM_STR_MAX + 1];
+    u32     n;
     u8      i,
             j;
 
 
     for (i = 0; i < 4; i++)
     {
+        n = 0;
         for (j = 0; j < 4; j++)
         {
-            printf("%f ", matrix.elements[i + j * 4]);
+            n += mho_f32_to_str(matrix.elements[i + j * 4], line + n);
+            line[n++] = ' ';
         }
-        printf("\n");
+        line[n++] = '\n';
+        fwrite(line, 1, n, stdout);
     }
 }
 
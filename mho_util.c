@@ -1,62 +1,669 @@
+// Exposes the POSIX/GNU APIs (pthread_rwlock_t, ...) when building with -std=c*
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+    #define _GNU_SOURCE
+#endif
+
+// 64-bit off_t (fseeko, pread, ...) on 32-bit targets too
+#if !defined(_FILE_OFFSET_BITS)
+    #define _FILE_OFFSET_BITS 64
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
+#include <errno.h>
+#include <stdarg.h>
+#include <time.h>
+#if defined(_WIN32) || defined(_WIN64)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+    #include <sys/types.h>
+    #include <sys/stat.h>
+#else
+    #include <pthread.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+    #include <emmintrin.h>
+    #define MHO_SSE2
+#endif
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_AMD64) || defined(_M_IX86)
+    // Code paths for newer instruction sets are compiled in regardless of the
+    // compiler flags (see MHO_TARGET) and picked at runtime
+    #include <immintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+    #define MHO_X86
+#endif
 #include "mho.h"
 
+// Compiles a function for an instruction set beyond the baseline
+#if defined(__GNUC__) || defined(__clang__)
+    #define MHO_TARGET(__isa)   __attribute__((target(__isa)))
+#else
+    #define MHO_TARGET(__isa)
+#endif
+
+// String scans read whole aligned vectors and so may touch bytes past the
+// terminator (never past its page), which AddressSanitizer would report
+#if defined(__GNUC__) || defined(__clang__)
+    #define MHO_NO_ASAN         __attribute__((no_sanitize_address))
+#else
+    #define MHO_NO_ASAN
+#endif
+
+// Atomics: C11 <stdatomic.h>, or the Interlocked intrinsics with MSVC (whose
+// C mode has no stdatomic). Only relaxed, acquire and release orderings on
+// 32-bit, 64-bit and pointer-sized unsigned integers are used.
+#if defined(_MSC_VER) && !defined(__clang__)
+    typedef volatile LONG       mho__atomic_u32;
+    typedef volatile LONG64     mho__atomic_u64;
+    #if defined(_WIN64)
+        typedef volatile LONG64 mho__atomic_usize;
+    #else
+        typedef volatile LONG   mho__atomic_usize;
+    #endif
+
+    // x86 loads and stores already have acquire/release semantics, only the
+    // compiler must not reorder around them
+    #if defined(_M_IX86) || defined(_M_X64)
+        #define mho__atomic_fence()     _ReadWriteBarrier()
+    #else
+        #define mho__atomic_fence()     MemoryBarrier()
+    #endif
+
+internal u32
+mho__atomic_load32(volatile LONG *p,
+                   b32 acquire)
+{
+    u32     v = (u32)*p;
+
+
+    if (acquire)
+        mho__atomic_fence();
+
+    return v;
+}
+
+// Plain 64-bit accesses aren't atomic on 32-bit targets
+internal u64
+mho__atomic_load64(volatile LONG64 *p,
+                   b32 acquire)
+{
+#if defined(_WIN64)
+    u64     v = (u64)*p;
+
+
+    if (acquire)
+        mho__atomic_fence();
+
+    return v;
+#else
+    (void)acquire;
+    return (u64)InterlockedCompareExchange64(p, 0, 0);
+#endif
+}
+
+internal void
+mho__atomic_store32(volatile LONG *p,
+                    u32 v,
+                    b32 release)
+{
+    if (release)
+        mho__atomic_fence();
+    *p = (LONG)v;
+}
+
+internal void
+mho__atomic_store64(volatile LONG64 *p,
+                    u64 v,
+                    b32 release)
+{
+#if defined(_WIN64)
+    if (release)
+        mho__atomic_fence();
+    *p = (LONG64)v;
+#else
+    (void)release;
+    InterlockedExchange64(p, (LONG64)v);
+#endif
+}
+
+internal b32
+mho__atomic_cas32(volatile LONG *p,
+                  u32 *expected,
+                  u32 desired)
+{
+    u32     prev = (u32)InterlockedCompareExchange(p, (LONG)desired, (LONG)*expected);
+
+
+    if (prev == *expected)
+        return TRUE;
+    *expected = prev;
+
+    return FALSE;
+}
+
+internal b32
+mho__atomic_cas64(volatile LONG64 *p,
+                  u64 *expected,
+                  u64 desired)
+{
+    u64     prev = (u64)InterlockedCompareExchange64(p, (LONG64)desired, (LONG64)*expected);
+
+
+    if (prev == *expected)
+        return TRUE;
+    *expected = prev;
+
+    return FALSE;
+}
+
+    // The width is picked off the operand (both branches must compile, only
+    // the matching one is ever taken)
+    #define mho__atomic_is64(__p)   (sizeof(*(__p)) == 8)
+
+    #define mho__atomic_init(__p, __v) \
+        mho__atomic_store((__p), (__v))
+    #define mho__atomic_load(__p) \
+        (mho__atomic_is64(__p) ? mho__atomic_load64((volatile LONG64 *)(__p), FALSE) : mho__atomic_load32((volatile LONG *)(__p), FALSE))
+    #define mho__atomic_load_acquire(__p) \
+        (mho__atomic_is64(__p) ? mho__atomic_load64((volatile LONG64 *)(__p), TRUE) : mho__atomic_load32((volatile LONG *)(__p), TRUE))
+    #define mho__atomic_store(__p, __v) \
+        (mho__atomic_is64(__p) ? mho__atomic_store64((volatile LONG64 *)(__p), (u64)(__v), FALSE) : mho__atomic_store32((volatile LONG *)(__p), (u32)(__v), FALSE))
+    #define mho__atomic_store_release(__p, __v) \
+        (mho__atomic_is64(__p) ? mho__atomic_store64((volatile LONG64 *)(__p), (u64)(__v), TRUE) : mho__atomic_store32((volatile LONG *)(__p), (u32)(__v), TRUE))
+    #define mho__atomic_fetch_add(__p, __v) \
+        (mho__atomic_is64(__p) ? (u64)InterlockedExchangeAdd64((volatile LONG64 *)(__p), (LONG64)(__v)) : (u64)(u32)InterlockedExchangeAdd((volatile LONG *)(__p), (LONG)(__v)))
+    #define mho__atomic_cas(__p, __expected, __desired) \
+        (mho__atomic_is64(__p) ? mho__atomic_cas64((volatile LONG64 *)(__p), (u64 *)(__expected), (u64)(__desired)) : mho__atomic_cas32((volatile LONG *)(__p), (u32 *)(__expected), (u32)(__desired)))
+#else
+    #include <stdatomic.h>
+
+    typedef atomic_uint         mho__atomic_u32;
+    typedef atomic_ullong       mho__atomic_u64;
+    typedef atomic_size_t       mho__atomic_usize;
+
+    #define mho__atomic_init(__p, __v) \
+        atomic_init((__p), (__v))
+    #define mho__atomic_load(__p) \
+        atomic_load_explicit((__p), memory_order_relaxed)
+    #define mho__atomic_load_acquire(__p) \
+        atomic_load_explicit((__p), memory_order_acquire)
+    #define mho__atomic_store(__p, __v) \
+        atomic_store_explicit((__p), (__v), memory_order_relaxed)
+    #define mho__atomic_store_release(__p, __v) \
+        atomic_store_explicit((__p), (__v), memory_order_release)
+    #define mho__atomic_fetch_add(__p, __v) \
+        atomic_fetch_add_explicit((__p), (__v), memory_order_relaxed)
+    #define mho__atomic_cas(__p, __expected, __desired) \
+        atomic_compare_exchange_weak_explicit((__p), (__expected), (__desired), memory_order_relaxed, memory_order_relaxed)
+#endif
+
 // TODO: handle errors (ie, fptr is invalid)
 
 #pragma warning(disable: 4996) // fopen unsafe
 
+//-------------------- NEWLINES ----------------//
+
+#define MHO_FILE_CHUNK     (256 * 1024)
+
+// Index of the lowest set bit (mask must be non-zero)
+#if defined(_MSC_VER)
+internal u32
+mho__ctz(u32 mask)
+{
+    unsigned long   idx;
+
+
+    _BitScanForward(&idx, mask);
+
+    return (u32)idx;
+}
+
+internal u32
+mho__ctz64(u64 mask)
+{
+    unsigned long   idx;
+
+
+    _BitScanForward64(&idx, mask);
+
+    return (u32)idx;
+}
+
+// Number of zero bits above the highest set bit (mask must be non-zero)
+internal u32
+mho__clz64(u64 mask)
+{
+    unsigned long   idx;
+
+
+    _BitScanReverse64(&idx, mask);
+
+    return 63 - (u32)idx;
+}
+#else
+    #define mho__ctz(__mask)    ((u32)__builtin_ctz(__mask))
+    #define mho__ctz64(__mask)  ((u32)__builtin_ctzll(__mask))
+    #define mho__clz64(__mask)  ((u32)__builtin_clzll(__mask))
+#endif
+
+// Defined with the CPU feature detection (STDLIB)
+internal u32 mho__cpu(void);
+
+#if defined(MHO_X86)
+
+// AVX2 version of mho__count_newlines, over the whole 32-byte blocks of buf
+MHO_TARGET("avx2") internal u64
+mho__count_newlines_avx2(const u8 *buf,
+                         usize len)
+{
+    const __m256i       nl = _mm256_set1_epi8('\n');
+    __m256i             acc,
+                        sum = _mm256_setzero_si256();
+    __m128i             half;
+    usize               i = 0,
+                        run;
+    u64                 lanes[2];
+
+
+    while (len - i >= 32)
+    {
+        acc = _mm256_setzero_si256();
+        for (run = 0; run < 255 && len - i >= 32; run++, i += 32)
+            acc = _mm256_sub_epi8(acc, _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(buf + i)), nl));
+        sum = _mm256_add_epi64(sum, _mm256_sad_epu8(acc, _mm256_setzero_si256()));
+    }
+
+    half = _mm_add_epi64(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    _mm_storeu_si128((__m128i *)lanes, half);
+
+    return lanes[0] + lanes[1];
+}
+
+// AVX2 version of mho__index_newlines, over the whole 32-byte blocks of buf
+MHO_TARGET("avx2") internal void
+mho__index_newlines_avx2(mho_arr(u64) *index,
+                         const u8 *buf,
+                         usize len,
+                         u64 base)
+{
+    const __m256i       nl = _mm256_set1_epi8('\n');
+    usize               i;
+    u32                 mask;
+
+
+    for (i = 0; len - i >= 32; i += 32)
+    {
+        mask = (u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(buf + i)), nl));
+        while (mask)
+        {
+            mho_arr_push(*index, base + i + mho__ctz(mask) + 1);
+            mask &= mask - 1;
+        }
+    }
+}
+
+#endif // MHO_X86
+
+// Counts the '\n' bytes in a buffer. The compare results (0 or -1 per byte)
+// are subtracted into byte-wide counters, which are folded with a SAD every
+// 255 iterations before they can overflow.
+internal u64
+mho__count_newlines(const u8 *buf,
+                    usize len)
+{
+    u64         cnt = 0;
+    usize       i = 0,
+                run;
+
+
+#if defined(MHO_X86)
+    if (mho__cpu() & MHO_CPU_AVX2)
+    {
+        cnt = mho__count_newlines_avx2(buf, len);
+        i = len & ~(usize)31;
+    }
+#endif // MHO_X86
+
+#if defined(MHO_SSE2)
+    __m128i     nl = _mm_set1_epi8('\n'),
+                acc,
+                sum = _mm_setzero_si128();
+    u64         lanes[2];
+
+    while (len - i >= 16)
+    {
+        acc = _mm_setzero_si128();
+        for (run = 0; run < 255 && len - i >= 16; run++, i += 16)
+            acc = _mm_sub_epi8(acc, _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(buf + i)), nl));
+        sum = _mm_add_epi64(sum, _mm_sad_epu8(acc, _mm_setzero_si128()));
+    }
+    // The lane sums are full 64-bit counts (past 4 GiB of newlines they no
+    // longer fit 32 bits), stored rather than extracted for 32-bit targets
+    _mm_storeu_si128((__m128i *)lanes, sum);
+    cnt += lanes[0] + lanes[1];
+#endif // MHO_SSE2
+
+    (void)run;
+    for (; i < len; i++)
+        cnt += (buf[i] == '\n');
+
+    return cnt;
+}
+
+// Appends the offset of the byte following every '\n' in a buffer, with
+// base added to each
+internal void
+mho__index_newlines(mho_arr(u64) *index,
+                    const u8 *buf,
+                    usize len,
+                    u64 base)
+{
+    usize       i = 0;
+
+
+#if defined(MHO_X86)
+    if (mho__cpu() & MHO_CPU_AVX2)
+    {
+        mho__index_newlines_avx2(index, buf, len, base);
+        i = len & ~(usize)31;
+    }
+#endif // MHO_X86
+
+#if defined(MHO_SSE2)
+    __m128i     nl = _mm_set1_epi8('\n');
+    u32         mask;
+
+    for (; len - i >= 16; i += 16)
+    {
+        mask = (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(buf + i)), nl));
+        while (mask)
+        {
+            mho_arr_push(*index, base + i + mho__ctz(mask) + 1);
+            mask &= mask - 1;
+        }
+    }
+#endif // MHO_SSE2
+
+    for (; i < len; i++)
+    {
+        if (buf[i] == '\n')
+            mho_arr_push(*index, base + i + 1);
+    }
+}
+
+//-------------------- FILE DESCRIPTORS ----------------//
+
+// Thin layer over raw file descriptors/handles, used where stdio would cost
+// an extra copy or a seek to learn the size
+
+#define MHO_FADVISE_MIN     (1024 * 1024)
+
+// 64-bit stdio positioning (ftell/fseek use long, which is 32-bit on Win64)
+#if defined(_WIN32) || defined(_WIN64)
+    #define mho__ftell(__f)             _ftelli64(__f)
+    #define mho__fseek(__f, __o, __w)   _fseeki64((__f), (__o), (__w))
+#else
+    #define mho__ftell(__f)             ((s64)ftello(__f))
+    #define mho__fseek(__f, __o, __w)   fseeko((__f), (off_t)(__o), (__w))
+#endif
+
+#if defined(_WIN32) || defined(_WIN64)
+    typedef HANDLE      mho__fd_t;
+
+    #define MHO__FD_INVALID     INVALID_HANDLE_VALUE
+#else
+    typedef int         mho__fd_t;
+
+    #define MHO__FD_INVALID     (-1)
+#endif
+
+internal mho__fd_t
+mho__fd_open(const char *filename)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    return CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+                       OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+#else
+    return open(filename, O_RDONLY | O_CLOEXEC);
+#endif
+}
+
+internal void
+mho__fd_close(mho__fd_t fd)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    CloseHandle(fd);
+#else
+    close(fd);
+#endif
+}
+
+// Gets the size of an open regular file
+internal b32
+mho__fd_size(mho__fd_t fd,
+             u64 *size)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    LARGE_INTEGER       file_size;
+
+
+    if (GetFileType(fd) != FILE_TYPE_DISK || !GetFileSizeEx(fd, &file_size))
+        return FALSE;
+    *size = (u64)file_size.QuadPart;
+#else
+    struct stat         st;
+
+
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+        return FALSE;
+    *size = (u64)st.st_size;
+#endif
+
+    return TRUE;
+}
+
+// Gets the size of the regular file behind a FILE *, without seeking
+internal b32
+mho__file_sizef(FILE *file,
+                u64 *size)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    struct _stat64      st;
+
+
+    if (_fstat64(_fileno(file), &st) != 0 || !(st.st_mode & _S_IFREG))
+        return FALSE;
+#else
+    struct stat         st;
+
+
+    if (fstat(fileno(file), &st) != 0 || !S_ISREG(st.st_mode))
+        return FALSE;
+#endif
+    *size = (u64)st.st_size;
+
+    return TRUE;
+}
+
+// Tells the kernel that [offset, offset + len) is about to be read front to
+// back. Only worth the syscall for larger reads.
+internal void
+mho__fd_advise(mho__fd_t fd,
+               u64 offset,
+               u64 len)
+{
+#if defined(POSIX_FADV_SEQUENTIAL)
+    if (len >= MHO_FADVISE_MIN)
+    {
+        posix_fadvise(fd, (off_t)offset, (off_t)len, POSIX_FADV_SEQUENTIAL);
+        posix_fadvise(fd, (off_t)offset, (off_t)len, POSIX_FADV_WILLNEED);
+    }
+#else
+    (void)fd;
+    (void)offset;
+    (void)len;
+#endif
+}
+
+// Reads up to len bytes at offset into dst without touching the file
+// position (so it's safe to call from several threads at once). Returns the
+// number of bytes read, which is short only at the end of the file, or -1.
+internal s64
+mho__fd_pread(mho__fd_t fd,
+              void *dst,
+              u64 len,
+              u64 offset)
+{
+    u64                 total = 0;
+#if defined(_WIN32) || defined(_WIN64)
+    OVERLAPPED          ov;
+    DWORD               bytes_read;
+
+
+    while (total < len)
+    {
+        memset(&ov, 0, sizeof(OVERLAPPED));
+        ov.Offset = (DWORD)(offset + total);
+        ov.OffsetHigh = (DWORD)((offset + total) >> 32);
+        if (!ReadFile(fd, (u8 *)dst + total, (DWORD)mho_min(len - total, 1u << 30), &bytes_read, &ov))
+        {
+            if (GetLastError() == ERROR_HANDLE_EOF)
+                break;
+            return -1;
+        }
+        if (bytes_read == 0)
+            break;
+        total += bytes_read;
+    }
+#else
+    ssize_t             bytes_read;
+
+
+    while (total < len)
+    {
+        bytes_read = pread(fd, (u8 *)dst + total, (size_t)mho_min(len - total, 1u << 30), (off_t)(offset + total));
+        if (bytes_read < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return -1;
+        }
+        if (bytes_read == 0)
+            break;
+        total += (u64)bytes_read;
+    }
+#endif
+
+    return (s64)total;
+}
+
+// Reads up to len bytes from the current position, for files that can't be
+// read positionally (pipes, ...). Returns the number of bytes read or -1.
+internal s64
+mho__fd_read(mho__fd_t fd,
+             void *dst,
+             u64 len)
+{
+    u64                 total = 0;
+#if defined(_WIN32) || defined(_WIN64)
+    DWORD               bytes_read;
+
+
+    while (total < len)
+    {
+        if (!ReadFile(fd, (u8 *)dst + total, (DWORD)mho_min(len - total, 1u << 30), &bytes_read, NULL))
+        {
+            if (GetLastError() == ERROR_BROKEN_PIPE)
+                break;
+            return -1;
+        }
+        if (bytes_read == 0)
+            break;
+        total += bytes_read;
+    }
+#else
+    ssize_t             bytes_read;
+
+
+    while (total < len)
+    {
+        bytes_read = read(fd, (u8 *)dst + total, (size_t)mho_min(len - total, 1u << 30));
+        if (bytes_read < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return -1;
+        }
+        if (bytes_read == 0)
+            break;
+        total += (u64)bytes_read;
+    }
+#endif
+
+    return (s64)total;
+}
+
 //-------------------- FILES ----------------//
 
 char *
 mho_file_read(const char *filename,
               usize byte_cnt)
 {
-    char        *buffer;
-    FILE        *fptr;
-    usize       bytes_read;
+    char        *buffer = NULL;
+    mho__fd_t   fd;
+    u64         size;
+    s64         bytes_read;
 
 
-    fptr = fopen(filename, "rb");
-    if (fptr)
+    fd = mho__fd_open(filename);
+    if (fd == MHO__FD_INVALID)
     {
-        if (byte_cnt == 0)
-            byte_cnt = (usize)mho_file_lenf(fptr);
+        fprintf(stderr, "Could not load file: %s\n", filename);
+        return NULL;
+    }
 
-        if (byte_cnt != -1)
+    if (byte_cnt == 0)
+    {
+        if (mho__fd_size(fd, &size) && size < (u64)(usize)-1)
         {
-            buffer = (char *)malloc(byte_cnt + 1);
-            if (buffer)
-            {
-                bytes_read = fread(buffer, 1, byte_cnt, fptr);
-                if (bytes_read == byte_cnt)
-                {
-                    buffer[byte_cnt] = 0;
-                }
-                else
-                {
-                    fprintf(stderr, "Could not read full file: %s\n", filename);
-                    buffer = NULL;
-                }
-            }
-            else
-            {
-                fprintf(stderr, "Could not allocate %u bytes for buffer for file: %s\n", byte_cnt, filename);
-                buffer = NULL;
-            }
+            byte_cnt = (usize)size;
         }
         else
         {
             fprintf(stderr, "Could not read file length: %s\n", filename);
+            mho__fd_close(fd);
+            return NULL;
+        }
+    }
+
+    buffer = (char *)malloc(byte_cnt + 1);
+    if (buffer)
+    {
+        bytes_read = mho__fd_pread(fd, buffer, byte_cnt, 0);
+        if (bytes_read == (s64)byte_cnt)
+        {
+            buffer[byte_cnt] = 0;
+        }
+        else
+        {
+            fprintf(stderr, "Could not read full file: %s\n", filename);
+            free(buffer);
             buffer = NULL;
         }
     }
     else
     {
-        fprintf(stderr, "Could not load file: %s\n", filename);
-        buffer = NULL;
+        fprintf(stderr, "Could not allocate %llu bytes for buffer for file: %s\n", (unsigned long long)byte_cnt, filename);
     }
-    fclose(fptr);
+    mho__fd_close(fd);
 
     return buffer;
 }
@@ -75,12 +682,14 @@ mho_file_write(const char *filename,
     if (fptr)
     {
         if (byte_cnt == 0)
-            byte_cnt = mho_strlen(buffer);
+            byte_cnt = mho_strlen((s8 *)buffer);
 
         bytes_written = fwrite(buffer, 1, byte_cnt, fptr);
         if (bytes_written != byte_cnt)
         {
-            fprintf(stderr, "Could not write %u bytes to file: %s (wrote %u / %u)", byte_cnt, filename, bytes_written, byte_cnt);
+            fprintf(stderr, "Could not write %llu bytes to file: %s (wrote %llu / %llu)", (unsigned long long)byte_cnt, filename,
+                                                                                   (unsigned long long)bytes_written,
+                                                                                   (unsigned long long)byte_cnt);
             ret = -1;
         }
     }
@@ -108,12 +717,14 @@ mho_file_append(const char *filename,
     if (fptr)
     {
         if (byte_cnt == 0)
-            byte_cnt = mho_strlen(buffer);
+            byte_cnt = mho_strlen((s8 *)buffer);
 
         bytes_written = fwrite(buffer, 1, byte_cnt, fptr);
         if (bytes_written != byte_cnt)
         {
-            fprintf(stderr, "Could not write %u bytes to file: %s (wrote %u / %u)", byte_cnt, filename, bytes_written, byte_cnt);
+            fprintf(stderr, "Could not write %llu bytes to file: %s (wrote %llu / %llu)", (unsigned long long)byte_cnt, filename,
+                                                                                   (unsigned long long)bytes_written,
+                                                                                   (unsigned long long)byte_cnt);
             ret = -1;
         }
     }
@@ -127,256 +738,8173 @@ mho_file_append(const char *filename,
     return ret;
 }
 
-long
+s64
 mho_file_len(const char *filename)
 {
-    long        len = -1;
-    FILE        *fptr;
+    s64         len = -1;
+    mho__fd_t   fd;
+    u64         size;
 
 
-    fptr = fopen(filename, "rb");
-    if (fptr)
+    fd = mho__fd_open(filename);
+    if (fd != MHO__FD_INVALID)
     {
-        fseek(fptr, 0, SEEK_END);
-        len = ftell(fptr);
+        if (mho__fd_size(fd, &size))
+            len = (s64)size;
+        mho__fd_close(fd);
     }
-    fclose(fptr);
 
     return len;
 }
 
-
-u32
+u64
 mho_file_lines(const char *filename)
 {
-    u32         ln_cnt = 0;
-    FILE        *fptr;
-    s32         c;
+    u64         ln_cnt = 0;
+    mho_fmap_t  map;
 
 
-    fptr = fopen(filename, "rb");
-    if (fptr)
+    if (mho_file_map(filename, MHO_FMAP_SEQUENTIAL | MHO_FMAP_WILLNEED, &map))
     {
-        do
-        {
-            c = fgetc(fptr);
-            if (c == '\n')
-                ln_cnt++;
-        } while (c != EOF);
+        ln_cnt = mho__count_newlines(map.data, (usize)map.len);
+        mho_file_unmap(&map);
     }
 
     return ln_cnt;
 }
 
-char *
-mho_file_readf(FILE *file,
-               usize byte_cnt)
+b32
+mho_file_read_into(const char *filename,
+                   void *buffer,
+                   usize capacity,
+                   usize *len)
 {
-    long        pos;
-    char        *buffer = NULL;
-    usize       bytes_read;
+    mho__fd_t   fd;
+    u64         size;
+    s64         bytes_read;
+    b32         ret = FALSE;
 
 
-    pos = ftell(file);
-    if (byte_cnt == 0)
-        byte_cnt = (usize)mho_file_lenf(file);
+    *len = 0;
+    fd = mho__fd_open(filename);
+    if (fd == MHO__FD_INVALID)
+    {
+        fprintf(stderr, "Could not load file: %s\n", filename);
+        return FALSE;
+    }
 
-    if (byte_cnt != -1)
+    if (mho__fd_size(fd, &size) && size > 0)
     {
-        buffer = (char *)malloc(byte_cnt + 1);
-        if (buffer)
+        // Report the size needed, so the caller can grow its buffer and retry
+        *len = (usize)size;
+        if (size <= capacity)
         {
-            bytes_read = fread(buffer, 1, byte_cnt, file);
-            if (bytes_read == byte_cnt)
+            mho__fd_advise(fd, 0, size);
+            bytes_read = mho__fd_pread(fd, buffer, size, 0);
+            if (bytes_read >= 0)
             {
-                buffer[byte_cnt] = 0;
+                *len = (usize)bytes_read;
+                ret = TRUE;
             }
         }
     }
-    fseek(file, pos, SEEK_SET);
-
-    return buffer;
-}
-
-b32
-mho_file_writef(FILE *file,
-                char *buffer,
-                usize byte_cnt)
-{
-    long        pos;
-    b32         ret = 1;
-    usize       bytes_written;
-
-    pos = ftell(file);
-    if (byte_cnt == 0)
-        byte_cnt = mho_strlen(buffer);
-
-    bytes_written = fwrite(buffer, 1, byte_cnt, file);
-    if (bytes_written != byte_cnt)
+    else
     {
-        fprintf(stderr, "failed to write full bytes!");
-        ret = -1;
+        // The size isn't known up front (pipes, /proc, ...), so read until
+        // the buffer is full and check there's nothing left
+        bytes_read = mho__fd_read(fd, buffer, capacity);
+        if (bytes_read >= 0 && (bytes_read < (s64)capacity || mho__fd_read(fd, &size, 1) == 0))
+        {
+            *len = (usize)bytes_read;
+            ret = TRUE;
+        }
     }
-    fseek(file, pos, SEEK_SET);
+    mho__fd_close(fd);
 
     return ret;
 }
 
 b32
-mho_file_appendf(FILE *file,
-                 char *buffer,
-                 usize byte_cnt)
+mho_file_read_arr(const char *filename,
+                  mho_arr(char) *buffer)
 {
-    long        pos;
-    b32         ret = 1;
-    usize       bytes_written;
+    mho__fd_t   fd;
+    u64         size;
+    s64         bytes_read = -1;
+    char        *arr = *buffer,
+                *grown;
 
-    pos = ftell(file);
-    if (byte_cnt == 0)
-        byte_cnt = mho_strlen(buffer);
 
-    bytes_written = fwrite(buffer, 1, byte_cnt, file);
-    if (bytes_written != byte_cnt)
+    mho_arr_clear(arr);
+    fd = mho__fd_open(filename);
+    if (fd == MHO__FD_INVALID)
     {
-        fprintf(stderr, "failed to append bytes!\n");
+        fprintf(stderr, "Could not load file: %s\n", filename);
+        return FALSE;
+    }
+
+    // Only grows the buffer, so steady-state reloads don't allocate. A failed
+    // grow leaves the caller's array as it was.
+    if (mho__fd_size(fd, &size) && size > 0)
+    {
+        grown = (char *)mho__arr_ensure(arr, sizeof(char), (usize)size + 1);
+        if (grown)
+        {
+            arr = grown;
+            mho__fd_advise(fd, 0, size);
+            bytes_read = mho__fd_pread(fd, arr, size, 0);
+            if (bytes_read >= 0)
+                mho_arr_head(arr)->size = (u64)bytes_read;
+        }
+    }
+    else
+    {
+        // The size isn't known up front (pipes, /proc, ...)
+        do
+        {
+            grown = (char *)mho__arr_ensure(arr, sizeof(char), MHO_FILE_CHUNK + 1);
+            if (!grown)
+            {
+                bytes_read = -1;
+                break;
+            }
+            arr = grown;
+            bytes_read = mho__fd_read(fd, arr + mho_arr_size(arr), MHO_FILE_CHUNK);
+            if (bytes_read > 0)
+                mho_arr_head(arr)->size += (u64)bytes_read;
+        } while (bytes_read > 0);
+        if (bytes_read == 0)
+            bytes_read = (s64)mho_arr_size(arr);
+    }
+    mho__fd_close(fd);
+
+    *buffer = arr;
+    if (bytes_read >= 0)
+        arr[mho_arr_size(arr)] = 0;
+
+    return bytes_read >= 0;
+}
+
+char *
+mho_file_readf(FILE *file,
+               usize byte_cnt)
+{
+    s64         pos;
+    u64         size;
+    char        *buffer = NULL;
+    usize       bytes_read;
+
+
+    pos = mho__ftell(file);
+    if (byte_cnt == 0)
+    {
+        // The whole file, from the start
+        if (pos < 0 || !mho__file_sizef(file, &size) || size >= (u64)(usize)-1 ||
+            mho__fseek(file, 0, SEEK_SET) != 0)
+            return NULL;
+        byte_cnt = (usize)size;
+    }
+
+    buffer = (char *)malloc(byte_cnt + 1);
+    if (buffer)
+    {
+        bytes_read = fread(buffer, 1, byte_cnt, file);
+        buffer[bytes_read] = 0;
+    }
+    mho__fseek(file, pos, SEEK_SET);
+
+    return buffer;
+}
+
+b32
+mho_file_writef(FILE *file,
+                char *buffer,
+                usize byte_cnt)
+{
+    s64         pos;
+    b32         ret = 1;
+    usize       bytes_written;
+
+    pos = mho__ftell(file);
+    if (byte_cnt == 0)
+        byte_cnt = mho_strlen((s8 *)buffer);
+
+    bytes_written = fwrite(buffer, 1, byte_cnt, file);
+    if (bytes_written != byte_cnt)
+    {
+        fprintf(stderr, "failed to write full bytes!");
+        ret = -1;
+    }
+    mho__fseek(file, pos, SEEK_SET);
+
+    return ret;
+}
+
+b32
+mho_file_appendf(FILE *file,
+                 char *buffer,
+                 usize byte_cnt)
+{
+    s64         pos;
+    b32         ret = 1;
+    usize       bytes_written;
+
+    pos = mho__ftell(file);
+    if (byte_cnt == 0)
+        byte_cnt = mho_strlen((s8 *)buffer);
+
+    bytes_written = fwrite(buffer, 1, byte_cnt, file);
+    if (bytes_written != byte_cnt)
+    {
+        fprintf(stderr, "failed to append bytes!\n");
         ret = -1;
     }
-    fseek(file, pos, SEEK_SET);
+    mho__fseek(file, pos, SEEK_SET);
 
     return ret;
 }
 
-long
+s64
 mho_file_lenf(FILE *fp)
 {
-    long        len,
+    s64         len,
                 pos;
 
 
-    pos = ftell(fp);
-    fseek(fp, 0, SEEK_END);
-    len = ftell(fp);
-    fseek(fp, pos, SEEK_SET);
+    pos = mho__ftell(fp);
+    mho__fseek(fp, 0, SEEK_END);
+    len = mho__ftell(fp);
+    mho__fseek(fp, pos, SEEK_SET);
 
     return len;
 }
 
-u32
+u64
 mho_file_linesf(FILE *file)
 {
-    long        pos;
-    u32         ln_cnt = 0;
-    s32         c;
+    s64         pos;
+    u64         ln_cnt = 0;
+    u8          *buffer;
+    usize       bytes_read;
 
 
-    pos = ftell(file);
-    do
-    {
-        c = fgetc(file);
-        if (c == '\n')
-            ln_cnt++;
-    } while (c != EOF);
-    fseek(file, pos, SEEK_SET);
+    buffer = (u8 *)malloc(MHO_FILE_CHUNK);
+    if (!buffer)
+        return 0;
+
+    pos = mho__ftell(file);
+    while ((bytes_read = fread(buffer, 1, MHO_FILE_CHUNK, file)) > 0)
+        ln_cnt += mho__count_newlines(buffer, bytes_read);
+    mho__fseek(file, pos, SEEK_SET);
+    free(buffer);
 
     return ln_cnt;
 }
 
-//-------------------- STDLIB ----------------//
+//-------------------- MAPPED FILES ----------------//
 
-void
-mho_memcpy(void *dest,
-           void *src,
-           usize n)
+#if defined(_WIN32) || defined(_WIN64)
+
+// Reads everything left in a handle into a heap buffer (for non-disk handles)
+internal b32
+mho__fmap_read_all(HANDLE file,
+                   mho_fmap_t *map)
 {
-    usize       i;
+    mho_arr(u8)     buffer = NULL;
+    u8              *grown;
+    DWORD           bytes_read;
 
 
-    for (i = 0; i < n; i++)
+    for (;;)
     {
-        ((s8 *)dest)[i] = ((s8 *)src)[i];
+        // One extra byte is always reserved for the terminator
+        grown = (u8 *)mho__arr_ensure(buffer, sizeof(u8), 64 * 1024 + 1);
+        if (!grown)
+        {
+            mho_arr_free(buffer);
+            return FALSE;
+        }
+        buffer = grown;
+
+        if (!ReadFile(file, buffer + mho_arr_size(buffer), 64 * 1024, &bytes_read, NULL))
+        {
+            // A pipe whose writer has closed reports EOF as an error
+            if (GetLastError() == ERROR_BROKEN_PIPE)
+                break;
+            mho_arr_free(buffer);
+            return FALSE;
+        }
+        if (bytes_read == 0)
+            break;
+        mho_arr_head(buffer)->size += bytes_read;
     }
+
+    map->len = mho_arr_size(buffer);
+    buffer[map->len] = 0;
+    map->data = buffer;
+    map->mapped = FALSE;
+
+    return TRUE;
 }
 
-void *
-mho_memset(void *dest,
-           s32 c,
-           usize n)
+b32
+mho_file_map(const char *filename,
+             u32 hints,
+             mho_fmap_t *map)
 {
-    u8          uc = (u8)c;
-    usize       i;
+    HANDLE          file,
+                    mapping;
+    LARGE_INTEGER   size;
+    b32             ret = FALSE;
 
 
-    for (i = 0; i < n; i++)
+    memset(map, 0, sizeof(mho_fmap_t));
+    file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                       (hints & MHO_FMAP_SEQUENTIAL) ? FILE_FLAG_SEQUENTIAL_SCAN :
+                       (hints & MHO_FMAP_RANDOM) ? FILE_FLAG_RANDOM_ACCESS : FILE_ATTRIBUTE_NORMAL,
+                       NULL);
+    if (file == INVALID_HANDLE_VALUE)
     {
-        ((u8 *)dest)[i] = uc;
+        fprintf(stderr, "Could not load file: %s\n", filename);
+        return FALSE;
     }
 
-    return dest;
+    // Empty files can't be mapped, so they're read normally along with pipes etc.
+    if (GetFileType(file) != FILE_TYPE_DISK || !GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+        ret = mho__fmap_read_all(file, map);
+    }
+    else
+    {
+        mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping)
+        {
+            map->data = (const u8 *)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            if (map->data)
+            {
+                map->len = (u64)size.QuadPart;
+                map->mapped = TRUE;
+                map->handle = mapping;
+                ret = TRUE;
+            }
+            else
+            {
+                CloseHandle(mapping);
+            }
+        }
+    }
+    CloseHandle(file);
+
+    if (!ret)
+        fprintf(stderr, "Could not map file: %s\n", filename);
+
+    return ret;
 }
 
 void
-mho_strcpy(s8 *dest,
-           s8 *src)
+mho_file_unmap(mho_fmap_t *map)
+{
+    if (map->mapped)
+    {
+        UnmapViewOfFile(map->data);
+        CloseHandle((HANDLE)map->handle);
+    }
+    else
+    {
+        mho__arr_free((void *)map->data, 1);
+    }
+
+    memset(map, 0, sizeof(mho_fmap_t));
+}
+
+#else
+
+// Reads everything left in a descriptor into a heap buffer (for non-regular files)
+internal b32
+mho__fmap_read_all(int fd,
+                   mho_fmap_t *map)
+{
+    mho_arr(u8)     buffer = NULL;
+    u8              *grown;
+    ssize_t         bytes_read;
+
+
+    for (;;)
+    {
+        // One extra byte is always reserved for the terminator
+        grown = (u8 *)mho__arr_ensure(buffer, sizeof(u8), 64 * 1024 + 1);
+        if (!grown)
+        {
+            mho_arr_free(buffer);
+            return FALSE;
+        }
+        buffer = grown;
+
+        bytes_read = read(fd, buffer + mho_arr_size(buffer), 64 * 1024);
+        if (bytes_read < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            mho_arr_free(buffer);
+            return FALSE;
+        }
+        if (bytes_read == 0)
+            break;
+        mho_arr_head(buffer)->size += (usize)bytes_read;
+    }
+
+    map->len = mho_arr_size(buffer);
+    buffer[map->len] = 0;
+    map->data = buffer;
+    map->mapped = FALSE;
+
+    return TRUE;
+}
+
+b32
+mho_file_map(const char *filename,
+             u32 hints,
+             mho_fmap_t *map)
 {
-    while (*dest != 0)
+    int             fd;
+    struct stat     st;
+    void            *data;
+    b32             ret = FALSE;
+
+
+    memset(map, 0, sizeof(mho_fmap_t));
+    fd = open(filename, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        fprintf(stderr, "Could not load file: %s\n", filename);
+        return FALSE;
+    }
+
+    // Empty files can't be mapped, and some "files" (/proc, ...) report a
+    // size of 0 despite having contents, so both are read normally
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0)
+    {
+        ret = mho__fmap_read_all(fd, map);
+    }
+    else
     {
-        *dest++ = *src++;
+        data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED)
+        {
+            if (hints & MHO_FMAP_SEQUENTIAL)
+                madvise(data, (size_t)st.st_size, MADV_SEQUENTIAL);
+            if (hints & MHO_FMAP_RANDOM)
+                madvise(data, (size_t)st.st_size, MADV_RANDOM);
+            if (hints & MHO_FMAP_WILLNEED)
+                madvise(data, (size_t)st.st_size, MADV_WILLNEED);
+#ifdef MADV_HUGEPAGE
+            if (hints & MHO_FMAP_HUGEPAGE)
+                madvise(data, (size_t)st.st_size, MADV_HUGEPAGE);
+#endif // MADV_HUGEPAGE
+
+            map->data = (const u8 *)data;
+            map->len = (u64)st.st_size;
+            map->mapped = TRUE;
+            ret = TRUE;
+        }
     }
+    close(fd);
+
+    if (!ret)
+        fprintf(stderr, "Could not map file: %s\n", filename);
+
+    return ret;
 }
 
 void
-mho_strncpy(s8 *dest,
-            s8 *src,
-            usize n)
+mho_file_unmap(mho_fmap_t *map)
 {
-    usize       i;
+    if (map->mapped)
+        munmap((void *)map->data, (size_t)map->len);
+    else
+        mho__arr_free((void *)map->data, 1);
 
+    memset(map, 0, sizeof(mho_fmap_t));
+}
 
-    for (i = 0; i < n; i++)
+#endif // _WIN32 || _WIN64
+
+mho_arr(u64)
+mho_file_line_index(const char *filename)
+{
+    mho_arr(u64)    index = NULL;
+    mho_fmap_t      map;
+
+
+    if (mho_file_map(filename, MHO_FMAP_SEQUENTIAL | MHO_FMAP_WILLNEED, &map))
     {
-        dest[i] = src[i];
+        if (map.len)
+            mho_arr_push(index, 0);
+        mho__index_newlines(&index, map.data, (usize)map.len, 0);
+
+        // A trailing newline doesn't start another line
+        if (mho_arr_size(index) > 1 && index[mho_arr_size(index) - 1] == map.len)
+            mho_arr_head(index)->size--;
+
+        mho_file_unmap(&map);
     }
+
+    return index;
 }
 
-usize
-mho_strlen(s8 *str)
+//-------------------- STDLIB ----------------//
+
+// Size above which copies/fills bypass the cache with non-temporal stores
+#ifndef MHO_NT_THRESHOLD
+    #define MHO_NT_THRESHOLD    (8 * 1024 * 1024)
+#endif
+
+#if defined(MHO_X86)
+internal void
+mho__cpuid(u32 leaf,
+           u32 subleaf,
+           u32 *regs)
+{
+ #if defined(_MSC_VER)
+    __cpuidex((int *)regs, (int)leaf, (int)subleaf);
+ #else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+ #endif
+}
+
+internal u64
+mho__xgetbv(u32 idx)
+{
+ #if defined(_MSC_VER)
+    return _xgetbv(idx);
+ #else
+    u32                 lo,
+                        hi;
+
+
+    __asm__ __volatile__("xgetbv" : "=a"(lo), "=d"(hi) : "c"(idx));
+
+    return ((u64)hi << 32) | lo;
+ #endif
+}
+#endif // MHO_X86
+
+internal u32
+mho__cpu_detect(void)
 {
-    usize       len = 0;
+    u32                 features = 0;
+#if defined(MHO_X86)
+    u32                 regs[4],
+                        max_leaf;
+    u64                 xcr0 = 0;
 
 
-    while (*str++ != '\0')
+    mho__cpuid(0, 0, regs);
+    max_leaf = regs[0];
+
+    mho__cpuid(1, 0, regs);
+    if (regs[3] & (1u << 26))
+        features |= MHO_CPU_SSE2;
+    if (regs[2] & (1u << 20))
+        features |= MHO_CPU_SSE42;
+
+    // The OS has to save the AVX (and AVX-512) registers too
+    if (regs[2] & (1u << 27))
+        xcr0 = mho__xgetbv(0);
+
+    if (max_leaf >= 7 && (regs[2] & (1u << 28)) && (xcr0 & 0x06) == 0x06)
     {
-        len++;
+        mho__cpuid(7, 0, regs);
+        if (regs[1] & (1u << 5))
+            features |= MHO_CPU_AVX2;
+        if ((regs[1] & (1u << 16)) && (regs[1] & (1u << 30)) && (xcr0 & 0xE6) == 0xE6)
+            features |= MHO_CPU_AVX512;
     }
+#endif
 
-    return len;
+    return features;
 }
 
-s8 *
-mho_strcat(s8 *str1,
-           s8 *str2)
+// Bit 31 marks the features as detected
+global mho__atomic_u32 mho__cpu_flags;
+
+internal u32
+mho__cpu(void)
 {
-    u32         size1,
-                size2,
-                index,
-                i;
-    s8          *new_str;
+    u32                 f = mho__atomic_load(&mho__cpu_flags);
+
 
+    if (!f)
+    {
+        f = mho__cpu_detect() | 0x80000000;
+        mho__atomic_store(&mho__cpu_flags, f);
+    }
+
+    return f;
+}
 
-    for (size1 = 0; str1[size1] != '\0'; size1++);
-    for (size2 = 0; str2[size2] != '\0'; size2++);
+u32
+mho_cpu_features(void)
+{
+    return mho__cpu() & 0x7FFFFFFF;
+}
 
-    new_str = (s8 *)malloc(size1 + size2);
+// Copies up to 16 bytes with two (possibly overlapping) moves
+internal void
+mho__memcpy_small(u8 *d,
+                  const u8 *s,
+                  usize n)
+{
+    u64                 a,
+                        b;
+    u32                 c,
+                        e;
 
-    for (index = 0; index < size1; index++)
-        new_str[index] = str1[index];
-    for (i = 0; index < (size1 + size2); index++, i++)
-        new_str[index] = str2[i];
 
-    return new_str;
+    if (n >= 8)
+    {
+        memcpy(&a, s, 8);
+        memcpy(&b, s + n - 8, 8);
+        memcpy(d, &a, 8);
+        memcpy(d + n - 8, &b, 8);
+    }
+    else if (n >= 4)
+    {
+        memcpy(&c, s, 4);
+        memcpy(&e, s + n - 4, 4);
+        memcpy(d, &c, 4);
+        memcpy(d + n - 4, &e, 4);
+    }
+    else if (n)
+    {
+        d[0] = s[0];
+        d[n / 2] = s[n / 2];
+        d[n - 1] = s[n - 1];
+    }
+}
+
+internal void
+mho__memset_small(u8 *d,
+                  u8 c,
+                  usize n)
+{
+    u64                 a = 0x0101010101010101ull * c;
+
+
+    if (n >= 8)
+    {
+        memcpy(d, &a, 8);
+        memcpy(d + n - 8, &a, 8);
+    }
+    else if (n >= 4)
+    {
+        memcpy(d, &a, 4);
+        memcpy(d + n - 4, &a, 4);
+    }
+    else if (n)
+    {
+        d[0] = c;
+        d[n / 2] = c;
+        d[n - 1] = c;
+    }
+}
+
+#if defined(MHO_X86)
+
+// Each vector width follows the same plan: sizes up to 4 vectors are
+// handled with overlapping loads/stores from both ends. Larger ones store
+// the first vector unaligned, save the last 4 vectors, then run a 4-vector
+// loop on the aligned destination and finish with the saved tail. Past
+// MHO_NT_THRESHOLD the loop uses streaming stores instead.
+
+MHO_TARGET("sse2") internal void
+mho__memcpy_sse2(u8 *d,
+                 const u8 *s,
+                 usize n,
+                 b32 nt)
+{
+    __m128i             a,
+                        b,
+                        c,
+                        e;
+    u8                  *dend = d + n;
+    usize               head;
+
+
+    if (n <= 32)
+    {
+        a = _mm_loadu_si128((const __m128i *)s);
+        b = _mm_loadu_si128((const __m128i *)(s + n - 16));
+        _mm_storeu_si128((__m128i *)d, a);
+        _mm_storeu_si128((__m128i *)(dend - 16), b);
+        return;
+    }
+    if (n <= 64)
+    {
+        a = _mm_loadu_si128((const __m128i *)s);
+        b = _mm_loadu_si128((const __m128i *)(s + 16));
+        c = _mm_loadu_si128((const __m128i *)(s + n - 32));
+        e = _mm_loadu_si128((const __m128i *)(s + n - 16));
+        _mm_storeu_si128((__m128i *)d, a);
+        _mm_storeu_si128((__m128i *)(d + 16), b);
+        _mm_storeu_si128((__m128i *)(dend - 32), c);
+        _mm_storeu_si128((__m128i *)(dend - 16), e);
+        return;
+    }
+
+    a = _mm_loadu_si128((const __m128i *)(s + n - 64));
+    b = _mm_loadu_si128((const __m128i *)(s + n - 48));
+    c = _mm_loadu_si128((const __m128i *)(s + n - 32));
+    e = _mm_loadu_si128((const __m128i *)(s + n - 16));
+    _mm_storeu_si128((__m128i *)d, _mm_loadu_si128((const __m128i *)s));
+
+    head = 16 - ((usize)d & 15);
+    d += head;
+    s += head;
+    n -= head;
+    if (nt)
+    {
+        for (; n > 64; n -= 64, d += 64, s += 64)
+        {
+            _mm_stream_si128((__m128i *)d, _mm_loadu_si128((const __m128i *)s));
+            _mm_stream_si128((__m128i *)(d + 16), _mm_loadu_si128((const __m128i *)(s + 16)));
+            _mm_stream_si128((__m128i *)(d + 32), _mm_loadu_si128((const __m128i *)(s + 32)));
+            _mm_stream_si128((__m128i *)(d + 48), _mm_loadu_si128((const __m128i *)(s + 48)));
+        }
+        _mm_sfence();
+    }
+    else
+    {
+        for (; n > 64; n -= 64, d += 64, s += 64)
+        {
+            _mm_store_si128((__m128i *)d, _mm_loadu_si128((const __m128i *)s));
+            _mm_store_si128((__m128i *)(d + 16), _mm_loadu_si128((const __m128i *)(s + 16)));
+            _mm_store_si128((__m128i *)(d + 32), _mm_loadu_si128((const __m128i *)(s + 32)));
+            _mm_store_si128((__m128i *)(d + 48), _mm_loadu_si128((const __m128i *)(s + 48)));
+        }
+    }
+
+    _mm_storeu_si128((__m128i *)(dend - 64), a);
+    _mm_storeu_si128((__m128i *)(dend - 48), b);
+    _mm_storeu_si128((__m128i *)(dend - 32), c);
+    _mm_storeu_si128((__m128i *)(dend - 16), e);
 }
 
+MHO_TARGET("avx2") internal void
+mho__memcpy_avx2(u8 *d,
+                 const u8 *s,
+                 usize n,
+                 b32 nt)
+{
+    __m256i             a,
+                        b,
+                        c,
+                        e;
+    u8                  *dend = d + n;
+    usize               head;
+
+
+    if (n <= 64)
+    {
+        mho__memcpy_sse2(d, s, n, FALSE);
+        return;
+    }
+    if (n <= 128)
+    {
+        a = _mm256_loadu_si256((const __m256i *)s);
+        b = _mm256_loadu_si256((const __m256i *)(s + 32));
+        c = _mm256_loadu_si256((const __m256i *)(s + n - 64));
+        e = _mm256_loadu_si256((const __m256i *)(s + n - 32));
+        _mm256_storeu_si256((__m256i *)d, a);
+        _mm256_storeu_si256((__m256i *)(d + 32), b);
+        _mm256_storeu_si256((__m256i *)(dend - 64), c);
+        _mm256_storeu_si256((__m256i *)(dend - 32), e);
+        return;
+    }
 
+    a = _mm256_loadu_si256((const __m256i *)(s + n - 128));
+    b = _mm256_loadu_si256((const __m256i *)(s + n - 96));
+    c = _mm256_loadu_si256((const __m256i *)(s + n - 64));
+    e = _mm256_loadu_si256((const __m256i *)(s + n - 32));
+    _mm256_storeu_si256((__m256i *)d, _mm256_loadu_si256((const __m256i *)s));
+
+    head = 32 - ((usize)d & 31);
+    d += head;
+    s += head;
+    n -= head;
+    if (nt)
+    {
+        for (; n > 128; n -= 128, d += 128, s += 128)
+        {
+            _mm256_stream_si256((__m256i *)d, _mm256_loadu_si256((const __m256i *)s));
+            _mm256_stream_si256((__m256i *)(d + 32), _mm256_loadu_si256((const __m256i *)(s + 32)));
+            _mm256_stream_si256((__m256i *)(d + 64), _mm256_loadu_si256((const __m256i *)(s + 64)));
+            _mm256_stream_si256((__m256i *)(d + 96), _mm256_loadu_si256((const __m256i *)(s + 96)));
+        }
+        _mm_sfence();
+    }
+    else
+    {
+        for (; n > 128; n -= 128, d += 128, s += 128)
+        {
+            _mm256_store_si256((__m256i *)d, _mm256_loadu_si256((const __m256i *)s));
+            _mm256_store_si256((__m256i *)(d + 32), _mm256_loadu_si256((const __m256i *)(s + 32)));
+            _mm256_store_si256((__m256i *)(d + 64), _mm256_loadu_si256((const __m256i *)(s + 64)));
+            _mm256_store_si256((__m256i *)(d + 96), _mm256_loadu_si256((const __m256i *)(s + 96)));
+        }
+    }
+
+    _mm256_storeu_si256((__m256i *)(dend - 128), a);
+    _mm256_storeu_si256((__m256i *)(dend - 96), b);
+    _mm256_storeu_si256((__m256i *)(dend - 64), c);
+    _mm256_storeu_si256((__m256i *)(dend - 32), e);
+}
+
+MHO_TARGET("avx512f") internal void
+mho__memcpy_avx512(u8 *d,
+                   const u8 *s,
+                   usize n,
+                   b32 nt)
+{
+    __m512i             a,
+                        b,
+                        c,
+                        e;
+    u8                  *dend = d + n;
+    usize               head;
+
+
+    if (n <= 256)
+    {
+        mho__memcpy_avx2(d, s, n, FALSE);
+        return;
+    }
+
+    a = _mm512_loadu_si512((const void *)(s + n - 256));
+    b = _mm512_loadu_si512((const void *)(s + n - 192));
+    c = _mm512_loadu_si512((const void *)(s + n - 128));
+    e = _mm512_loadu_si512((const void *)(s + n - 64));
+    _mm512_storeu_si512((void *)d, _mm512_loadu_si512((const void *)s));
+
+    head = 64 - ((usize)d & 63);
+    d += head;
+    s += head;
+    n -= head;
+    if (nt)
+    {
+        for (; n > 256; n -= 256, d += 256, s += 256)
+        {
+            _mm512_stream_si512((void *)d, _mm512_loadu_si512((const void *)s));
+            _mm512_stream_si512((void *)(d + 64), _mm512_loadu_si512((const void *)(s + 64)));
+            _mm512_stream_si512((void *)(d + 128), _mm512_loadu_si512((const void *)(s + 128)));
+            _mm512_stream_si512((void *)(d + 192), _mm512_loadu_si512((const void *)(s + 192)));
+        }
+        _mm_sfence();
+    }
+    else
+    {
+        for (; n > 256; n -= 256, d += 256, s += 256)
+        {
+            _mm512_store_si512((void *)d, _mm512_loadu_si512((const void *)s));
+            _mm512_store_si512((void *)(d + 64), _mm512_loadu_si512((const void *)(s + 64)));
+            _mm512_store_si512((void *)(d + 128), _mm512_loadu_si512((const void *)(s + 128)));
+            _mm512_store_si512((void *)(d + 192), _mm512_loadu_si512((const void *)(s + 192)));
+        }
+    }
+
+    _mm512_storeu_si512((void *)(dend - 256), a);
+    _mm512_storeu_si512((void *)(dend - 192), b);
+    _mm512_storeu_si512((void *)(dend - 128), c);
+    _mm512_storeu_si512((void *)(dend - 64), e);
+}
+
+MHO_TARGET("sse2") internal void
+mho__memset_sse2(u8 *d,
+                 u8 c,
+                 usize n,
+                 b32 nt)
+{
+    __m128i             v = _mm_set1_epi8((char)c);
+    u8                  *dend = d + n;
+    usize               head;
+
+
+    _mm_storeu_si128((__m128i *)d, v);
+    _mm_storeu_si128((__m128i *)(dend - 16), v);
+    if (n <= 32)
+        return;
+    if (n <= 64)
+    {
+        _mm_storeu_si128((__m128i *)(d + 16), v);
+        _mm_storeu_si128((__m128i *)(dend - 32), v);
+        return;
+    }
+
+    head = 16 - ((usize)d & 15);
+    d += head;
+    n -= head;
+    if (nt)
+    {
+        for (; n > 64; n -= 64, d += 64)
+        {
+            _mm_stream_si128((__m128i *)d, v);
+            _mm_stream_si128((__m128i *)(d + 16), v);
+            _mm_stream_si128((__m128i *)(d + 32), v);
+            _mm_stream_si128((__m128i *)(d + 48), v);
+        }
+        _mm_sfence();
+    }
+    else
+    {
+        for (; n > 64; n -= 64, d += 64)
+        {
+            _mm_store_si128((__m128i *)d, v);
+            _mm_store_si128((__m128i *)(d + 16), v);
+            _mm_store_si128((__m128i *)(d + 32), v);
+            _mm_store_si128((__m128i *)(d + 48), v);
+        }
+    }
+
+    _mm_storeu_si128((__m128i *)(dend - 64), v);
+    _mm_storeu_si128((__m128i *)(dend - 48), v);
+    _mm_storeu_si128((__m128i *)(dend - 32), v);
+}
+
+MHO_TARGET("avx2") internal void
+mho__memset_avx2(u8 *d,
+                 u8 c,
+                 usize n,
+                 b32 nt)
+{
+    __m256i             v = _mm256_set1_epi8((char)c);
+    u8                  *dend = d + n;
+    usize               head;
+
+
+    if (n <= 64)
+    {
+        mho__memset_sse2(d, c, n, FALSE);
+        return;
+    }
+
+    _mm256_storeu_si256((__m256i *)d, v);
+    _mm256_storeu_si256((__m256i *)(d + 32), v);
+    _mm256_storeu_si256((__m256i *)(dend - 64), v);
+    _mm256_storeu_si256((__m256i *)(dend - 32), v);
+    if (n <= 128)
+        return;
+
+    head = 32 - ((usize)d & 31);
+    d += head;
+    n -= head;
+    if (nt)
+    {
+        for (; n > 128; n -= 128, d += 128)
+        {
+            _mm256_stream_si256((__m256i *)d, v);
+            _mm256_stream_si256((__m256i *)(d + 32), v);
+            _mm256_stream_si256((__m256i *)(d + 64), v);
+            _mm256_stream_si256((__m256i *)(d + 96), v);
+        }
+        _mm_sfence();
+    }
+    else
+    {
+        for (; n > 128; n -= 128, d += 128)
+        {
+            _mm256_store_si256((__m256i *)d, v);
+            _mm256_store_si256((__m256i *)(d + 32), v);
+            _mm256_store_si256((__m256i *)(d + 64), v);
+            _mm256_store_si256((__m256i *)(d + 96), v);
+        }
+    }
+
+    _mm256_storeu_si256((__m256i *)(dend - 128), v);
+    _mm256_storeu_si256((__m256i *)(dend - 96), v);
+}
+
+MHO_TARGET("avx512f") internal void
+mho__memset_avx512(u8 *d,
+                   u8 c,
+                   usize n,
+                   b32 nt)
+{
+    __m512i             v = _mm512_set1_epi32((int)(0x01010101u * c));
+    u8                  *dend = d + n;
+    usize               head;
+
+
+    if (n <= 256)
+    {
+        mho__memset_avx2(d, c, n, FALSE);
+        return;
+    }
+
+    _mm512_storeu_si512((void *)d, v);
+
+    head = 64 - ((usize)d & 63);
+    d += head;
+    n -= head;
+    if (nt)
+    {
+        for (; n > 256; n -= 256, d += 256)
+        {
+            _mm512_stream_si512((void *)d, v);
+            _mm512_stream_si512((void *)(d + 64), v);
+            _mm512_stream_si512((void *)(d + 128), v);
+            _mm512_stream_si512((void *)(d + 192), v);
+        }
+        _mm_sfence();
+    }
+    else
+    {
+        for (; n > 256; n -= 256, d += 256)
+        {
+            _mm512_store_si512((void *)d, v);
+            _mm512_store_si512((void *)(d + 64), v);
+            _mm512_store_si512((void *)(d + 128), v);
+            _mm512_store_si512((void *)(d + 192), v);
+        }
+    }
+
+    _mm512_storeu_si512((void *)(dend - 256), v);
+    _mm512_storeu_si512((void *)(dend - 192), v);
+    _mm512_storeu_si512((void *)(dend - 128), v);
+    _mm512_storeu_si512((void *)(dend - 64), v);
+}
+
+#endif // MHO_X86
+
+// Copies n > 16 bytes on the widest code path the CPU supports, with
+// streaming stores if nt is set
+internal void
+mho__memcpy_bulk(u8 *d,
+                 const u8 *s,
+                 usize n,
+                 b32 nt)
+{
+#if defined(MHO_X86)
+    u32                 features = mho__cpu();
+
+
+    // Short copies stay on 16 byte vectors
+    if (n <= 64)
+        mho__memcpy_sse2(d, s, n, nt);
+    else if (features & MHO_CPU_AVX512)
+        mho__memcpy_avx512(d, s, n, nt);
+    else if (features & MHO_CPU_AVX2)
+        mho__memcpy_avx2(d, s, n, nt);
+    else
+        mho__memcpy_sse2(d, s, n, nt);
+#else
+    u64                 w;
+    usize               i;
+
+
+    (void)nt;
+    for (i = 0; i + 8 <= n; i += 8)
+    {
+        memcpy(&w, s + i, 8);
+        memcpy(d + i, &w, 8);
+    }
+    mho__memcpy_small(d + n - 8, s + n - 8, 8);
+#endif
+}
+
+internal void
+mho__memset_bulk(u8 *d,
+                 u8 c,
+                 usize n,
+                 b32 nt)
+{
+#if defined(MHO_X86)
+    u32                 features = mho__cpu();
+
+
+    if (n <= 64)
+        mho__memset_sse2(d, c, n, nt);
+    else if (features & MHO_CPU_AVX512)
+        mho__memset_avx512(d, c, n, nt);
+    else if (features & MHO_CPU_AVX2)
+        mho__memset_avx2(d, c, n, nt);
+    else
+        mho__memset_sse2(d, c, n, nt);
+#else
+    u64                 w = 0x0101010101010101ull * c;
+    usize               i;
+
+
+    (void)nt;
+    for (i = 0; i + 8 <= n; i += 8)
+        memcpy(d + i, &w, 8);
+    memcpy(d + n - 8, &w, 8);
+#endif
+}
+
+void
+mho_memcpy(void *dest,
+           void *src,
+           usize n)
+{
+    if (n <= 16)
+        mho__memcpy_small((u8 *)dest, (const u8 *)src, n);
+    else
+        mho__memcpy_bulk((u8 *)dest, (const u8 *)src, n, n >= MHO_NT_THRESHOLD);
+}
+
+void *
+mho_memset(void *dest,
+           s32 c,
+           usize n)
+{
+    if (n <= 16)
+        mho__memset_small((u8 *)dest, (u8)c, n);
+    else
+        mho__memset_bulk((u8 *)dest, (u8)c, n, n >= MHO_NT_THRESHOLD);
+
+    return dest;
+}
+
+void
+mho_strcpy(s8 *dest,
+           s8 *src)
+{
+    while ((*dest++ = *src++) != 0)
+        ;
+}
+
+void
+mho_strncpy(s8 *dest,
+            s8 *src,
+            usize n)
+{
+    usize       i;
+
+
+    for (i = 0; i < n; i++)
+    {
+        dest[i] = src[i];
+    }
+}
+
+#if defined(MHO_X86)
+
+// The str* scans align their pointer down to the vector (or pair of
+// vectors) width and discard the mask bits before the start, so no load
+// ever crosses into the next page. The mem* scans stay within [ptr, ptr+n).
+
+MHO_TARGET("sse2") MHO_NO_ASAN internal usize
+mho__strlen_sse2(const u8 *str)
+{
+    const __m128i       zero = _mm_setzero_si128();
+    const u8            *p = (const u8 *)((usize)str & ~(usize)15);
+    u32                 mask;
+
+
+    mask = (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((const __m128i *)p), zero));
+    mask >>= (usize)str & 15;
+    if (mask)
+        return mho__ctz(mask);
+
+    for (;;)
+    {
+        p += 16;
+        mask = (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((const __m128i *)p), zero));
+        if (mask)
+            return (usize)(p - str) + mho__ctz(mask);
+    }
+}
+
+MHO_TARGET("avx2") MHO_NO_ASAN internal usize
+mho__strlen_avx2(const u8 *str)
+{
+    const __m256i       zero = _mm256_setzero_si256();
+    const u8            *p = (const u8 *)((usize)str & ~(usize)63);
+    __m256i             a,
+                        b;
+    u64                 mask;
+
+
+    // 64 bytes per step, the two vectors share a cache line
+    a = _mm256_load_si256((const __m256i *)p);
+    b = _mm256_load_si256((const __m256i *)(p + 32));
+    mask = (u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, zero)) |
+           ((u64)(u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(b, zero)) << 32);
+    mask >>= (usize)str & 63;
+    if (mask)
+        return mho__ctz64(mask);
+
+    for (;;)
+    {
+        p += 64;
+        a = _mm256_load_si256((const __m256i *)p);
+        b = _mm256_load_si256((const __m256i *)(p + 32));
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(a, b), zero)))
+        {
+            mask = (u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, zero)) |
+                   ((u64)(u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(b, zero)) << 32);
+            return (usize)(p - str) + mho__ctz64(mask);
+        }
+    }
+}
+
+// Returns the first byte equal to c or to the terminator
+MHO_TARGET("sse2") MHO_NO_ASAN internal const u8 *
+mho__strchr_sse2(const u8 *str,
+                 u8 c)
+{
+    const __m128i       zero = _mm_setzero_si128(),
+                        vc = _mm_set1_epi8((char)c);
+    const u8            *p = (const u8 *)((usize)str & ~(usize)15);
+    __m128i             a;
+    u32                 mask;
+
+
+    a = _mm_load_si128((const __m128i *)p);
+    mask = (u32)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(a, zero), _mm_cmpeq_epi8(a, vc)));
+    mask >>= (usize)str & 15;
+    if (mask)
+        return str + mho__ctz(mask);
+
+    for (;;)
+    {
+        p += 16;
+        a = _mm_load_si128((const __m128i *)p);
+        mask = (u32)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(a, zero), _mm_cmpeq_epi8(a, vc)));
+        if (mask)
+            return p + mho__ctz(mask);
+    }
+}
+
+MHO_TARGET("avx2") MHO_NO_ASAN internal const u8 *
+mho__strchr_avx2(const u8 *str,
+                 u8 c)
+{
+    const __m256i       zero = _mm256_setzero_si256(),
+                        vc = _mm256_set1_epi8((char)c);
+    const u8            *p = (const u8 *)((usize)str & ~(usize)31);
+    __m256i             a;
+    u32                 mask;
+
+
+    a = _mm256_load_si256((const __m256i *)p);
+    mask = (u32)_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(a, zero), _mm256_cmpeq_epi8(a, vc)));
+    mask >>= (usize)str & 31;
+    if (mask)
+        return str + mho__ctz(mask);
+
+    for (;;)
+    {
+        p += 32;
+        a = _mm256_load_si256((const __m256i *)p);
+        mask = (u32)_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(a, zero), _mm256_cmpeq_epi8(a, vc)));
+        if (mask)
+            return p + mho__ctz(mask);
+    }
+}
+
+MHO_TARGET("sse2") internal const u8 *
+mho__memchr_sse2(const u8 *p,
+                 u8 c,
+                 usize n)
+{
+    const __m128i       vc = _mm_set1_epi8((char)c);
+    usize               i;
+    u32                 mask;
+
+
+    for (i = 0; i + 16 <= n; i += 16)
+    {
+        mask = (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(p + i)), vc));
+        if (mask)
+            return p + i + mho__ctz(mask);
+    }
+
+    // Re-check the last (overlapping) vector instead of reading past n
+    if (i < n)
+    {
+        i = n - 16;
+        mask = (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(p + i)), vc));
+        if (mask)
+            return p + i + mho__ctz(mask);
+    }
+
+    return NULL;
+}
+
+MHO_TARGET("avx2") internal const u8 *
+mho__memchr_avx2(const u8 *p,
+                 u8 c,
+                 usize n)
+{
+    const __m256i       vc = _mm256_set1_epi8((char)c);
+    __m256i             a,
+                        b;
+    usize               i;
+    u32                 mask;
+
+
+    for (i = 0; i + 64 <= n; i += 64)
+    {
+        a = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(p + i)), vc);
+        b = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(p + i + 32)), vc);
+        if (_mm256_movemask_epi8(_mm256_or_si256(a, b)))
+        {
+            mask = (u32)_mm256_movemask_epi8(a);
+            if (mask)
+                return p + i + mho__ctz(mask);
+            return p + i + 32 + mho__ctz((u32)_mm256_movemask_epi8(b));
+        }
+    }
+    for (; i + 32 <= n; i += 32)
+    {
+        mask = (u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(p + i)), vc));
+        if (mask)
+            return p + i + mho__ctz(mask);
+    }
+    if (i < n)
+    {
+        i = n - 32;
+        mask = (u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(p + i)), vc));
+        if (mask)
+            return p + i + mho__ctz(mask);
+    }
+
+    return NULL;
+}
+
+// First/last byte filter: candidate positions are those where both the
+// first and last byte of the needle match, only those get a full compare
+MHO_TARGET("sse2") internal usize
+mho__memmem_sse2(const u8 *h,
+                 usize n,
+                 const u8 *nd,
+                 usize m,
+                 const u8 **found)
+{
+    const __m128i       first = _mm_set1_epi8((char)nd[0]),
+                        last = _mm_set1_epi8((char)nd[m - 1]);
+    __m128i             a,
+                        b;
+    usize               i;
+    u32                 mask;
+
+
+    for (i = 0; i + m + 15 <= n; i += 16)
+    {
+        a = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(h + i)), first);
+        b = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(h + i + m - 1)), last);
+        mask = (u32)_mm_movemask_epi8(_mm_and_si128(a, b));
+        while (mask)
+        {
+            if (!memcmp(h + i + mho__ctz(mask) + 1, nd + 1, m - 2))
+            {
+                *found = h + i + mho__ctz(mask);
+                return i;
+            }
+            mask &= mask - 1;
+        }
+    }
+
+    return i;
+}
+
+MHO_TARGET("avx2") internal usize
+mho__memmem_avx2(const u8 *h,
+                 usize n,
+                 const u8 *nd,
+                 usize m,
+                 const u8 **found)
+{
+    const __m256i       first = _mm256_set1_epi8((char)nd[0]),
+                        last = _mm256_set1_epi8((char)nd[m - 1]);
+    __m256i             a,
+                        b;
+    usize               i;
+    u32                 mask;
+
+
+    for (i = 0; i + m + 31 <= n; i += 32)
+    {
+        a = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(h + i)), first);
+        b = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(h + i + m - 1)), last);
+        mask = (u32)_mm256_movemask_epi8(_mm256_and_si256(a, b));
+        while (mask)
+        {
+            if (!memcmp(h + i + mho__ctz(mask) + 1, nd + 1, m - 2))
+            {
+                *found = h + i + mho__ctz(mask);
+                return i;
+            }
+            mask &= mask - 1;
+        }
+    }
+
+    return i;
+}
+
+#else
+
+#define MHO__ONES       ((usize)-1 / 0xFF)
+#define MHO__HIGHS      (MHO__ONES * 0x80)
+#define MHO__HAS_ZERO(__w) (((__w) - MHO__ONES) & ~(__w) & MHO__HIGHS)
+
+// Word-at-a-time fallbacks, aligned words never cross a page
+MHO_NO_ASAN internal usize
+mho__strlen_word(const u8 *str)
+{
+    const u8            *p = str;
+    const usize         *w;
+
+
+    for (; (usize)p % sizeof(usize); p++)
+        if (!*p)
+            return (usize)(p - str);
+
+    for (w = (const usize *)p; !MHO__HAS_ZERO(*w); w++)
+        ;
+    for (p = (const u8 *)w; *p; p++)
+        ;
+
+    return (usize)(p - str);
+}
+
+MHO_NO_ASAN internal const u8 *
+mho__strchr_word(const u8 *str,
+                 u8 c)
+{
+    const usize         *w;
+    usize               vc = MHO__ONES * c;
+
+
+    for (; (usize)str % sizeof(usize); str++)
+        if (!*str || *str == c)
+            return str;
+
+    for (w = (const usize *)str; !MHO__HAS_ZERO(*w) && !MHO__HAS_ZERO(*w ^ vc); w++)
+        ;
+    for (str = (const u8 *)w; *str && *str != c; str++)
+        ;
+
+    return str;
+}
+
+#endif // MHO_X86
+
+usize
+mho_strlen(s8 *str)
+{
+#if defined(MHO_X86)
+    if (mho__cpu() & MHO_CPU_AVX2)
+        return mho__strlen_avx2((const u8 *)str);
+
+    return mho__strlen_sse2((const u8 *)str);
+#else
+    return mho__strlen_word((const u8 *)str);
+#endif
+}
+
+s8 *
+mho_strchr(const s8 *str,
+           s32 c)
+{
+    const u8            *p;
+
+
+#if defined(MHO_X86)
+    if (mho__cpu() & MHO_CPU_AVX2)
+        p = mho__strchr_avx2((const u8 *)str, (u8)c);
+    else
+        p = mho__strchr_sse2((const u8 *)str, (u8)c);
+#else
+    p = mho__strchr_word((const u8 *)str, (u8)c);
+#endif
+
+    return *p == (u8)c ? (s8 *)p : NULL;
+}
+
+void *
+mho_memchr(const void *ptr,
+           s32 c,
+           usize n)
+{
+    const u8            *p = (const u8 *)ptr;
+    usize               i;
+
+
+#if defined(MHO_X86)
+    if (n >= 32 && (mho__cpu() & MHO_CPU_AVX2))
+        return (void *)mho__memchr_avx2(p, (u8)c, n);
+    if (n >= 16)
+        return (void *)mho__memchr_sse2(p, (u8)c, n);
+#endif
+
+    for (i = 0; i < n; i++)
+        if (p[i] == (u8)c)
+            return (void *)(p + i);
+
+    return NULL;
+}
+
+void *
+mho_memmem(const void *hay,
+           usize hay_len,
+           const void *needle,
+           usize needle_len)
+{
+    const u8            *h = (const u8 *)hay,
+                        *nd = (const u8 *)needle;
+    usize               i = 0;
+#if defined(MHO_X86)
+    const u8            *found = NULL;
+#endif
+
+
+    if (!needle_len)
+        return (void *)h;
+    if (needle_len > hay_len)
+        return NULL;
+    if (needle_len == 1)
+        return mho_memchr(h, nd[0], hay_len);
+
+#if defined(MHO_X86)
+    if (mho__cpu() & MHO_CPU_AVX2)
+        i = mho__memmem_avx2(h, hay_len, nd, needle_len, &found);
+    else
+        i = mho__memmem_sse2(h, hay_len, nd, needle_len, &found);
+    if (found)
+        return (void *)found;
+#endif
+
+    // Positions the vector loop could not cover without reading past the end
+    for (; i + needle_len <= hay_len; i++)
+    {
+        if (h[i] == nd[0] && h[i + needle_len - 1] == nd[needle_len - 1] &&
+            !memcmp(h + i + 1, nd + 1, needle_len - 2))
+            return (void *)(h + i);
+    }
+
+    return NULL;
+}
+
+s8 *
+mho_strstr(const s8 *hay,
+           const s8 *needle)
+{
+    usize               needle_len = mho_strlen((s8 *)needle);
+    const s8            *p;
+
+
+    if (!needle_len)
+        return (s8 *)hay;
+
+    // Jump straight to the first candidate before measuring the rest
+    p = mho_strchr(hay, needle[0]);
+    if (!p)
+        return NULL;
+
+    return (s8 *)mho_memmem(p, mho_strlen((s8 *)p), needle, needle_len);
+}
+
+s8 *
+mho_strcat(s8 *str1,
+           s8 *str2)
+{
+    usize       size1,
+                size2;
+    s8          *new_str;
+
+
+    size1 = strlen((char *)str1);
+    size2 = strlen((char *)str2);
+
+    new_str = (s8 *)malloc(size1 + size2 + 1);
+    if (new_str)
+    {
+        memcpy(new_str, str1, size1);
+        memcpy(new_str + size1, str2, size2 + 1);
+    }
+
+    return new_str;
+}
+
+//-------------------- HASHING ----------------//
+
+// mho_hash reads its input in 64 byte stripes of 8 lanes, each lane adding
+// the 32x32 bit product of its halves (keyed) to one accumulator and its raw
+// value to the neighbouring one. That maps onto SSE2/AVX2 multiplies, and the
+// accumulators are scrambled every block of 16 stripes. Inputs of up to 64
+// bytes take a short path instead.
+
+#define MHO_HASH_STRIPE         64
+#define MHO_HASH_BLOCK_STRIPES  16
+#define MHO_HASH_P32            0x9E3779B1ULL
+#define MHO_HASH_P64_1          0x9E3779B185EBCA87ULL
+#define MHO_HASH_P64_2          0xC2B2AE3D27D4EB4FULL
+
+global const u64 mho_hash_secret[16] =
+{
+    0xBE4BA423396CFEB8ULL, 0x1CAD21F72C81017CULL, 0xDB979083E96DD4DEULL, 0x1F67B3B7A4A44072ULL,
+    0x78E5C0CC4EE679CBULL, 0x2172FFCC7DD05A82ULL, 0x8E2443F7744608B8ULL, 0x4C263A81E69035E0ULL,
+    0xCB00C391BB52283CULL, 0xA32E531B8B65D088ULL, 0x4EF90DA297486471ULL, 0xD8ACDEA946EF1938ULL,
+    0x3F349CE33F76FAA8ULL, 0x1D4F0BC7C7BBDCF9ULL, 0x3159B4CD4BE0518AULL, 0x647378D9C97E9FC8ULL,
+};
+
+internal u64
+mho__read64(const u8 *p)
+{
+    u64                 v;
+
+
+    memcpy(&v, p, 8);
+
+    return v;
+}
+
+internal u64
+mho__read32(const u8 *p)
+{
+    u32                 v;
+
+
+    memcpy(&v, p, 4);
+
+    return v;
+}
+
+// Full 128-bit product of a and b, returns the low half
+internal u64
+mho__mul128(u64 a,
+            u64 b,
+            u64 *hi)
+{
+#if defined(__SIZEOF_INT128__)
+    __uint128_t         r = (__uint128_t)a * b;
+
+
+    *hi = (u64)(r >> 64);
+
+    return (u64)r;
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return _umul128(a, b, hi);
+#else
+    u64                 lo_lo = (a & 0xFFFFFFFF) * (b & 0xFFFFFFFF),
+                        hi_lo = (a >> 32) * (b & 0xFFFFFFFF),
+                        lo_hi = (a & 0xFFFFFFFF) * (b >> 32),
+                        hi_hi = (a >> 32) * (b >> 32),
+                        cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+
+
+    *hi = hi_hi + (hi_lo >> 32) + (cross >> 32);
+
+    return (cross << 32) | (lo_lo & 0xFFFFFFFF);
+#endif
+}
+
+// Folds the 128-bit product of a and b into 64 bits
+internal u64
+mho__hash_mum(u64 a,
+              u64 b)
+{
+    u64                 hi,
+                        lo;
+
+
+    lo = mho__mul128(a, b, &hi);
+
+    return lo ^ hi;
+}
+
+internal u64
+mho__hash_avalanche(u64 h)
+{
+    h ^= h >> 37;
+    h *= 0x165667919E3779F9ULL;
+    h ^= h >> 32;
+
+    return h;
+}
+
+// Key i of a seed (odd keys subtract it), the short path only needs a few
+// so it derives them inline instead of filling a whole key array
+#define MHO_HASH_KEY(__i, __seed) \
+    (mho_hash_secret[(__i)] + (((__i) & 1) ? 0 - (__seed) : (__seed)))
+
+// Hashes 0 to 64 bytes
+internal u64
+mho__hash_short(const u8 *p,
+                usize len,
+                u64 seed)
+{
+    u64                 a,
+                        b;
+
+
+    if (len <= 16)
+    {
+        if (len >= 4)
+        {
+            a = (mho__read32(p) << 32) | mho__read32(p + ((len >> 3) << 2));
+            b = (mho__read32(p + len - 4) << 32) | mho__read32(p + len - 4 - ((len >> 3) << 2));
+        }
+        else if (len)
+        {
+            a = ((u64)p[0] << 16) | ((u64)p[len >> 1] << 8) | p[len - 1];
+            b = 0;
+        }
+        else
+        {
+            a = b = 0;
+        }
+
+        return mho__hash_avalanche(mho__hash_mum(a ^ MHO_HASH_KEY(0, seed), b ^ MHO_HASH_KEY(1, seed) ^ len) ^ (len * MHO_HASH_P64_1));
+    }
+
+    a = mho__hash_mum(mho__read64(p) ^ MHO_HASH_KEY(0, seed), mho__read64(p + 8) ^ MHO_HASH_KEY(1, seed));
+    b = mho__hash_mum(mho__read64(p + len - 16) ^ MHO_HASH_KEY(2, seed), mho__read64(p + len - 8) ^ MHO_HASH_KEY(3, seed));
+    if (len > 32)
+    {
+        a ^= mho__hash_mum(mho__read64(p + 16) ^ MHO_HASH_KEY(4, seed), mho__read64(p + 24) ^ MHO_HASH_KEY(5, seed));
+        b ^= mho__hash_mum(mho__read64(p + len - 32) ^ MHO_HASH_KEY(6, seed), mho__read64(p + len - 24) ^ MHO_HASH_KEY(7, seed));
+    }
+
+    return mho__hash_avalanche(a + b + len * MHO_HASH_P64_2);
+}
+
+#if defined(MHO_X86)
+MHO_TARGET("sse2") internal void
+mho__hash_stripes_sse2(u64 *acc,
+                       const u64 *key,
+                       const u8 *p,
+                       usize cnt)
+{
+    __m128i             a[4],
+                        k[4],
+                        d,
+                        dk;
+    u32                 i;
+
+
+    for (i = 0; i < 4; i++)
+    {
+        a[i] = _mm_loadu_si128((const __m128i *)(acc + 2 * i));
+        k[i] = _mm_loadu_si128((const __m128i *)(key + 2 * i));
+    }
+
+    for (; cnt; cnt--, p += MHO_HASH_STRIPE)
+    {
+        for (i = 0; i < 4; i++)
+        {
+            d = _mm_loadu_si128((const __m128i *)(p + 16 * i));
+            dk = _mm_xor_si128(d, k[i]);
+            a[i] = _mm_add_epi64(a[i], _mm_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2)));
+            a[i] = _mm_add_epi64(a[i], _mm_mul_epu32(dk, _mm_srli_epi64(dk, 32)));
+        }
+    }
+
+    for (i = 0; i < 4; i++)
+        _mm_storeu_si128((__m128i *)(acc + 2 * i), a[i]);
+}
+
+MHO_TARGET("avx2") internal void
+mho__hash_stripes_avx2(u64 *acc,
+                       const u64 *key,
+                       const u8 *p,
+                       usize cnt)
+{
+    __m256i             a0 = _mm256_loadu_si256((const __m256i *)acc),
+                        a1 = _mm256_loadu_si256((const __m256i *)(acc + 4)),
+                        k0 = _mm256_loadu_si256((const __m256i *)key),
+                        k1 = _mm256_loadu_si256((const __m256i *)(key + 4)),
+                        d0,
+                        d1,
+                        dk0,
+                        dk1;
+
+
+    for (; cnt; cnt--, p += MHO_HASH_STRIPE)
+    {
+        d0 = _mm256_loadu_si256((const __m256i *)p);
+        d1 = _mm256_loadu_si256((const __m256i *)(p + 32));
+        dk0 = _mm256_xor_si256(d0, k0);
+        dk1 = _mm256_xor_si256(d1, k1);
+        a0 = _mm256_add_epi64(a0, _mm256_shuffle_epi32(d0, _MM_SHUFFLE(1, 0, 3, 2)));
+        a1 = _mm256_add_epi64(a1, _mm256_shuffle_epi32(d1, _MM_SHUFFLE(1, 0, 3, 2)));
+        a0 = _mm256_add_epi64(a0, _mm256_mul_epu32(dk0, _mm256_srli_epi64(dk0, 32)));
+        a1 = _mm256_add_epi64(a1, _mm256_mul_epu32(dk1, _mm256_srli_epi64(dk1, 32)));
+    }
+
+    _mm256_storeu_si256((__m256i *)acc, a0);
+    _mm256_storeu_si256((__m256i *)(acc + 4), a1);
+}
+#else
+internal void
+mho__hash_stripes_scalar(u64 *acc,
+                         const u64 *key,
+                         const u8 *p,
+                         usize cnt)
+{
+    u64                 v,
+                        k;
+    u32                 i;
+
+
+    for (; cnt; cnt--, p += MHO_HASH_STRIPE)
+    {
+        for (i = 0; i < 8; i++)
+        {
+            v = mho__read64(p + 8 * i);
+            k = v ^ key[i];
+            acc[i ^ 1] += v;
+            acc[i] += (k & 0xFFFFFFFF) * (k >> 32);
+        }
+    }
+}
+#endif
+
+// Consumes cnt whole stripes, scrambling the accumulators at block ends
+internal void
+mho__hash_consume(u64 *acc,
+                  const u64 *key,
+                  u32 *stripe_cnt,
+                  const u8 *p,
+                  usize cnt)
+{
+    usize               n;
+    u32                 i;
+#if defined(MHO_X86)
+    u32                 features = mho__cpu();
+#endif
+
+
+    while (cnt)
+    {
+        n = mho_min(cnt, (usize)(MHO_HASH_BLOCK_STRIPES - *stripe_cnt));
+#if defined(MHO_X86)
+        if (features & MHO_CPU_AVX2)
+            mho__hash_stripes_avx2(acc, key, p, n);
+        else
+            mho__hash_stripes_sse2(acc, key, p, n);
+#else
+        mho__hash_stripes_scalar(acc, key, p, n);
+#endif
+        p += n * MHO_HASH_STRIPE;
+        cnt -= n;
+        *stripe_cnt += (u32)n;
+
+        if (*stripe_cnt == MHO_HASH_BLOCK_STRIPES)
+        {
+            for (i = 0; i < 8; i++)
+            {
+                acc[i] ^= acc[i] >> 47;
+                acc[i] ^= key[8 + i];
+                acc[i] *= MHO_HASH_P32;
+            }
+            *stripe_cnt = 0;
+        }
+    }
+}
+
+internal u64
+mho__hash_merge(const u64 *acc,
+                const u64 *key,
+                u64 len)
+{
+    u64                 h = len * MHO_HASH_P64_1;
+    u32                 i;
+
+
+    for (i = 0; i < 8; i += 2)
+        h += mho__hash_mum(acc[i] ^ key[8 + i], acc[i + 1] ^ key[9 + i]);
+
+    return mho__hash_avalanche(h);
+}
+
+internal void
+mho__hash_setup(u64 *acc,
+                u64 *key,
+                u64 seed)
+{
+    u32                 i;
+
+
+    for (i = 0; i < 16; i++)
+        key[i] = MHO_HASH_KEY(i, seed);
+    for (i = 0; i < 8; i++)
+        acc[i] = mho_hash_secret[i] ^ mho_hash_secret[15 - i];
+}
+
+u64
+mho_hash(const void *data,
+         usize len,
+         u64 seed)
+{
+    const u8            *p = (const u8 *)data;
+    u64                 acc[8],
+                        key[16];
+    u8                  tail[MHO_HASH_STRIPE];
+    usize               full;
+    u32                 stripe_cnt = 0;
+
+
+    if (len <= MHO_HASH_STRIPE)
+        return mho__hash_short(p, len, seed);
+
+    mho__hash_setup(acc, key, seed);
+
+    full = len / MHO_HASH_STRIPE;
+    mho__hash_consume(acc, key, &stripe_cnt, p, full);
+
+    // The partial last stripe is zero padded (len goes into the merge)
+    if (len % MHO_HASH_STRIPE)
+    {
+        memset(tail, 0, sizeof(tail));
+        memcpy(tail, p + full * MHO_HASH_STRIPE, len % MHO_HASH_STRIPE);
+        mho__hash_consume(acc, key, &stripe_cnt, tail, 1);
+    }
+
+    return mho__hash_merge(acc, key, len);
+}
+
+void
+mho_hash_init(mho_hash_state_t *state,
+              u64 seed)
+{
+    mho__hash_setup(state->acc, state->key, seed);
+    state->total_len = 0;
+    state->buffer_len = 0;
+    state->stripe_cnt = 0;
+}
+
+void
+mho_hash_update(mho_hash_state_t *state,
+                const void *data,
+                usize len)
+{
+    const u8            *p = (const u8 *)data;
+    usize               n;
+
+
+    state->total_len += len;
+
+    // A full buffer is only consumed once more data follows it, so that
+    // inputs of up to one stripe are still whole for the short path
+    if (state->buffer_len)
+    {
+        n = mho_min(len, (usize)(MHO_HASH_STRIPE - state->buffer_len));
+        memcpy(state->buffer + state->buffer_len, p, n);
+        state->buffer_len += (u32)n;
+        p += n;
+        len -= n;
+        if (!len)
+            return;
+
+        mho__hash_consume(state->acc, state->key, &state->stripe_cnt, state->buffer, 1);
+        state->buffer_len = 0;
+    }
+
+    if (len > MHO_HASH_STRIPE)
+    {
+        n = (len - 1) / MHO_HASH_STRIPE;
+        mho__hash_consume(state->acc, state->key, &state->stripe_cnt, p, n);
+        p += n * MHO_HASH_STRIPE;
+        len -= n * MHO_HASH_STRIPE;
+    }
+
+    memcpy(state->buffer, p, len);
+    state->buffer_len = (u32)len;
+}
+
+u64
+mho_hash_final(const mho_hash_state_t *state)
+{
+    u64                 acc[8];
+    u8                  tail[MHO_HASH_STRIPE];
+    u32                 stripe_cnt = state->stripe_cnt;
+
+
+    if (state->total_len <= MHO_HASH_STRIPE)
+        return mho__hash_short(state->buffer, (usize)state->total_len, state->key[0] - mho_hash_secret[0]);
+
+    memcpy(acc, state->acc, sizeof(acc));
+    memset(tail, 0, sizeof(tail));
+    memcpy(tail, state->buffer, state->buffer_len);
+    mho__hash_consume(acc, state->key, &stripe_cnt, tail, 1);
+
+    return mho__hash_merge(acc, state->key, state->total_len);
+}
+
+// Software CRC32C (Castagnoli), one byte at a time off a lazily built table
+internal u32
+mho__crc32c_sw(u32 crc,
+               const void *data,
+               usize len)
+{
+    local u32           table[256];
+    local mho__atomic_u32 ready;
+    const u8            *p = (const u8 *)data;
+    u32                 i,
+                        j,
+                        c;
+
+
+    if (!mho__atomic_load_acquire(&ready))
+    {
+        // Racing threads all build the same table
+        for (i = 0; i < 256; i++)
+        {
+            c = i;
+            for (j = 0; j < 8; j++)
+                c = (c >> 1) ^ (0x82F63B78 & (0u - (c & 1)));
+            table[i] = c;
+        }
+        mho__atomic_store_release(&ready, 1);
+    }
+
+    crc = ~crc;
+    while (len--)
+        crc = table[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+
+    return ~crc;
+}
+
+#if defined(MHO_X86)
+MHO_TARGET("sse4.2") internal u32
+mho__crc32c_hw(u32 crc,
+               const void *data,
+               usize len)
+{
+    const u8            *p = (const u8 *)data;
+ #if defined(__x86_64__) || defined(_M_X64) || defined(_M_AMD64)
+    u64                 c = ~crc;
+
+
+    for (; len >= 8; len -= 8, p += 8)
+        c = _mm_crc32_u64(c, mho__read64(p));
+    crc = (u32)c;
+ #else
+    crc = ~crc;
+ #endif
+    for (; len >= 4; len -= 4, p += 4)
+        crc = _mm_crc32_u32(crc, (u32)mho__read32(p));
+    while (len--)
+        crc = _mm_crc32_u8(crc, *p++);
+
+    return ~crc;
+}
+#endif
+
+u32
+mho_crc32c(u32 crc,
+           const void *data,
+           usize len)
+{
+#if defined(MHO_X86)
+    if (mho__cpu() & MHO_CPU_SSE42)
+        return mho__crc32c_hw(crc, data, len);
+#endif
+
+    return mho__crc32c_sw(crc, data, len);
+}
+
+//-------------------- ALLOCATORS ----------------//
+
+#define MHO_ALIGN_UP(__n, __a) \
+    (((__n) + ((__a) - 1)) & ~((usize)(__a) - 1))
+
+internal void *
+mho__arena_alloc_cb(void *ctx,
+                    usize size)
+{
+    return mho_arena_alloc((mho_arena_t *)ctx, size);
+}
+
+internal void *
+mho__arena_realloc_cb(void *ctx,
+                      void *ptr,
+                      usize old_size,
+                      usize new_size)
+{
+    mho_arena_t     *arena = (mho_arena_t *)ctx;
+    void            *new_ptr;
+
+
+    if (!ptr)
+        return mho_arena_alloc(arena, new_size);
+
+    // The most recent allocation can simply be resized in place
+    if ((u8 *)ptr == arena->base + arena->last &&
+        arena->last + new_size <= arena->capacity)
+    {
+        arena->used = arena->last + new_size;
+        return ptr;
+    }
+
+    new_ptr = mho_arena_alloc(arena, new_size);
+    if (new_ptr)
+        memcpy(new_ptr, ptr, mho_min(old_size, new_size));
+
+    return new_ptr;
+}
+
+internal void
+mho__arena_free_cb(void *ctx,
+                   void *ptr,
+                   usize size)
+{
+    mho_arena_t     *arena = (mho_arena_t *)ctx;
+
+
+    (void)size;
+
+    // Only the most recent allocation can be given back
+    if ((u8 *)ptr == arena->base + arena->last)
+        arena->used = arena->last;
+}
+
+b32
+mho_arena_init(mho_arena_t *arena,
+               void *buffer,
+               usize capacity)
+{
+    arena->owns_base = (buffer == NULL);
+    if (!buffer)
+        buffer = malloc(capacity);
+
+    arena->base = (u8 *)buffer;
+    arena->capacity = buffer ? capacity : 0;
+    arena->used = 0;
+    arena->last = 0;
+    arena->allocator.alloc_fn = mho__arena_alloc_cb;
+    arena->allocator.realloc_fn = mho__arena_realloc_cb;
+    arena->allocator.free_fn = mho__arena_free_cb;
+    arena->allocator.ctx = arena;
+
+    return buffer != NULL;
+}
+
+void
+mho_arena_destroy(mho_arena_t *arena)
+{
+    if (arena->owns_base)
+        free(arena->base);
+
+    arena->base = NULL;
+    arena->capacity = 0;
+    arena->used = 0;
+    arena->last = 0;
+}
+
+void *
+mho_arena_alloc(mho_arena_t *arena,
+                usize size)
+{
+    usize       offset;
+
+
+    // Align the absolute address, in case a caller-provided buffer is not aligned
+    offset = MHO_ALIGN_UP((usize)(arena->base + arena->used), MHO_ALLOC_ALIGN) - (usize)arena->base;
+    if (offset > arena->capacity || size > arena->capacity - offset)
+        return NULL;
+
+    arena->last = offset;
+    arena->used = offset + size;
+
+    return arena->base + offset;
+}
+
+void
+mho_arena_reset(mho_arena_t *arena)
+{
+    arena->used = 0;
+    arena->last = 0;
+}
+
+mho_allocator_t *
+mho_arena_allocator(mho_arena_t *arena)
+{
+    return &arena->allocator;
+}
+
+#define MHO_BUMP_BLOCK_HEADER \
+    MHO_ALIGN_UP(sizeof(mho_bump_block_t), MHO_ALLOC_ALIGN)
+
+internal void *
+mho__bump_alloc_cb(void *ctx,
+                   usize size)
+{
+    return mho_bump_alloc((mho_bump_t *)ctx, size);
+}
+
+internal void *
+mho__bump_realloc_cb(void *ctx,
+                     void *ptr,
+                     usize old_size,
+                     usize new_size)
+{
+    mho_bump_t          *bump = (mho_bump_t *)ctx;
+    mho_bump_block_t    *block = bump->current;
+    u8                  *data;
+    void                *new_ptr;
+    usize               aligned_size;
+
+
+    if (!ptr)
+        return mho_bump_alloc(bump, new_size);
+
+    // The most recent allocation can be resized in place if the block has
+    // room (rounded like mho_bump_alloc, so the next allocation stays aligned)
+    if (ptr == bump->last && block)
+    {
+        data = (u8 *)block + MHO_BUMP_BLOCK_HEADER;
+        aligned_size = MHO_ALIGN_UP(new_size, MHO_ALLOC_ALIGN);
+        if ((usize)((u8 *)ptr - data) + aligned_size <= block->capacity)
+        {
+            block->used = (usize)((u8 *)ptr - data) + aligned_size;
+            return ptr;
+        }
+    }
+
+    new_ptr = mho_bump_alloc(bump, new_size);
+    if (new_ptr)
+        memcpy(new_ptr, ptr, mho_min(old_size, new_size));
+
+    return new_ptr;
+}
+
+internal void
+mho__bump_free_cb(void *ctx,
+                  void *ptr,
+                  usize size)
+{
+    // Memory is reclaimed by mho_bump_reset()
+    (void)ctx;
+    (void)ptr;
+    (void)size;
+}
+
+void
+mho_bump_init(mho_bump_t *bump,
+              usize block_size)
+{
+    bump->first = NULL;
+    bump->current = NULL;
+    bump->block_size = block_size ? block_size : 64 * 1024;
+    bump->last = NULL;
+    bump->allocator.alloc_fn = mho__bump_alloc_cb;
+    bump->allocator.realloc_fn = mho__bump_realloc_cb;
+    bump->allocator.free_fn = mho__bump_free_cb;
+    bump->allocator.ctx = bump;
+}
+
+void
+mho_bump_destroy(mho_bump_t *bump)
+{
+    mho_bump_block_t    *block,
+                        *next;
+
+
+    for (block = bump->first; block; block = next)
+    {
+        next = block->next;
+        free(block);
+    }
+
+    bump->first = NULL;
+    bump->current = NULL;
+    bump->last = NULL;
+}
+
+void *
+mho_bump_alloc(mho_bump_t *bump,
+               usize size)
+{
+    mho_bump_block_t    *block;
+    usize               offset;
+
+
+    size = MHO_ALIGN_UP(size, MHO_ALLOC_ALIGN);
+
+    // Walk forward through the (already allocated) blocks until one fits
+    block = bump->current;
+    while (block && block->used + size > block->capacity)
+    {
+        block = block->next;
+        if (block)
+            block->used = 0; // blocks past 'current' are stale since the last reset
+    }
+
+    if (!block)
+    {
+        block = (mho_bump_block_t *)malloc(MHO_BUMP_BLOCK_HEADER + mho_max(size, bump->block_size));
+        if (!block)
+            return NULL;
+
+        block->capacity = mho_max(size, bump->block_size);
+        block->used = 0;
+        if (bump->current)
+        {
+            block->next = bump->current->next;
+            bump->current->next = block;
+        }
+        else
+        {
+            block->next = bump->first;
+            bump->first = block;
+        }
+    }
+
+    offset = block->used;
+    block->used += size;
+    bump->current = block;
+    bump->last = (u8 *)block + MHO_BUMP_BLOCK_HEADER + offset;
+
+    return bump->last;
+}
+
+void
+mho_bump_reset(mho_bump_t *bump)
+{
+    bump->current = bump->first;
+    if (bump->current)
+        bump->current->used = 0;
+    bump->last = NULL;
+}
+
+mho_allocator_t *
+mho_bump_allocator(mho_bump_t *bump)
+{
+    return &bump->allocator;
+}
+
+
+
+//-------------------- HASH MAP ----------------//
+
+#define MHO_MAP_MIN_CAPACITY    16
+
+// Slots are resized once they are 7/8 full
+#define MHO_MAP_MAX_LOAD(__cap) \
+    ((__cap) - ((__cap) >> 3))
+
+// Distance of a slot from the home slot of the hash stored in it
+#define MHO_MAP_DIST(__slot, __hash, __mask) \
+    (((__slot) - ((__hash) & (__mask))) & (__mask))
+
+u64
+mho_map_hash_bytes(const void *key,
+                   usize key_size)
+{
+    return mho_hash(key, key_size, 0);
+}
+
+b32
+mho_map_eq_bytes(const void *a,
+                 const void *b,
+                 usize key_size)
+{
+    return memcmp(a, b, key_size) == 0;
+}
+
+u64
+mho_map_hash_str(const void *key,
+                 usize key_size)
+{
+    const char  *str = *(const char **)key;
+
+
+    (void)key_size;
+
+    return mho_map_hash_bytes(str, strlen(str));
+}
+
+b32
+mho_map_eq_str(const void *a,
+               const void *b,
+               usize key_size)
+{
+    (void)key_size;
+
+    return strcmp(*(const char **)a, *(const char **)b) == 0;
+}
+
+// Hashes a key into a (never 0) 32-bit slot hash
+internal u32
+mho__map_hash(mho_map_header_t *head,
+              const void *key)
+{
+    u64         h;
+
+
+    h = head->hash_fn(key, head->key_size);
+
+    return (u32)(h ^ (h >> 32)) | 0x80000000;
+}
+
+internal void
+mho__map_swap(u8 *a,
+              u8 *b,
+              u8 *tmp,
+              usize n)
+{
+    memcpy(tmp, a, n);
+    memcpy(a, b, n);
+    memcpy(b, tmp, n);
+}
+
+// Robin Hood insert of an entry that is known not to be in the map. The entry
+// in hand (key/val) is clobbered by displaced entries along the way.
+internal void
+mho__map_insert(mho_map_header_t *head,
+                u8 *keys,
+                u8 *vals,
+                u32 h,
+                u8 *key,
+                u8 *val)
+{
+    u64         mask = head->capacity - 1,
+                i,
+                dist = 0,
+                slot_dist;
+    usize       ks = head->key_size,
+                vs = head->val_size;
+    u8          *key_tmp = keys + head->capacity * ks,
+                *val_tmp = vals + head->capacity * vs;
+    b32         placed = FALSE;
+    u32         tmp;
+
+
+    for (i = h & mask; ; i = (i + 1) & mask, dist++)
+    {
+        if (head->hashes[i] == 0)
+        {
+            head->hashes[i] = h;
+            memcpy(keys + i * ks, key, ks);
+            memcpy(vals + i * vs, val, vs);
+            if (!placed)
+                head->slot = i;
+            break;
+        }
+
+        // Steal the slot from entries closer to their home
+        slot_dist = MHO_MAP_DIST(i, head->hashes[i], mask);
+        if (slot_dist < dist)
+        {
+            tmp = head->hashes[i];
+            head->hashes[i] = h;
+            h = tmp;
+            mho__map_swap(keys + i * ks, key, key_tmp, ks);
+            mho__map_swap(vals + i * vs, val, val_tmp, vs);
+            if (!placed)
+            {
+                head->slot = i;
+                placed = TRUE;
+            }
+            dist = slot_dist;
+        }
+    }
+    head->size++;
+}
+
+// Rehashes the map into capacity slots
+internal b32
+mho__map_rehash(mho_map_header_t *head,
+                void **keys,
+                void **vals,
+                u64 capacity)
+{
+    mho_map_header_t    old = *head;
+    u8                  *old_keys = (u8 *)*keys,
+                        *old_vals = (u8 *)*vals,
+                        *block;
+    usize               hash_bytes,
+                        key_bytes;
+    u64                 i;
+
+
+    // Hashes, keys and values share one block (keys/vals get one extra scratch slot)
+    hash_bytes = MHO_ALIGN_UP((usize)capacity * sizeof(u32), MHO_ALLOC_ALIGN);
+    key_bytes = MHO_ALIGN_UP((usize)(capacity + 1) * head->key_size, MHO_ALLOC_ALIGN);
+    block = (u8 *)malloc(hash_bytes + key_bytes + (usize)(capacity + 1) * head->val_size);
+    if (!block)
+        return FALSE;
+
+    memset(block, 0, hash_bytes);
+    head->hashes = (u32 *)block;
+    head->capacity = capacity;
+    head->size = 0;
+    *keys = block + hash_bytes;
+    *vals = block + hash_bytes + key_bytes;
+
+    for (i = 0; i < old.capacity; i++)
+    {
+        if (old.hashes[i])
+        {
+            mho__map_insert(head, (u8 *)*keys, (u8 *)*vals, old.hashes[i],
+                            old_keys + i * old.key_size,
+                            old_vals + i * old.val_size);
+        }
+    }
+    free(old.hashes);
+
+    return TRUE;
+}
+
+void *
+mho__map_create(usize map_size,
+                usize key_size,
+                usize val_size)
+{
+    mho_map_header_t    *head;
+
+
+    head = (mho_map_header_t *)calloc(1, map_size);
+    if (head)
+    {
+        head->key_size = (u32)key_size;
+        head->val_size = (u32)val_size;
+        head->hash_fn = mho_map_hash_bytes;
+        head->eq_fn = mho_map_eq_bytes;
+    }
+
+    return head;
+}
+
+b32
+mho__map_reserve(mho_map_header_t *head,
+                 void **keys,
+                 void **vals,
+                 usize amount)
+{
+    u64         capacity;
+
+
+    capacity = head->capacity ? head->capacity : MHO_MAP_MIN_CAPACITY;
+    while (MHO_MAP_MAX_LOAD(capacity) < amount)
+        capacity *= 2;
+
+    if (capacity > head->capacity)
+        return mho__map_rehash(head, keys, vals, capacity);
+
+    return TRUE;
+}
+
+// Looks up a key given its slot hash, setting head->slot if it is found
+internal b32
+mho__map_find_hashed(mho_map_header_t *head,
+                     void *keys,
+                     const void *key,
+                     u32 h)
+{
+    u64         mask,
+                i,
+                dist = 0;
+    u32         slot_h;
+
+
+    if (head->size == 0)
+        return FALSE;
+
+    mask = head->capacity - 1;
+    for (i = h & mask; ; i = (i + 1) & mask, dist++)
+    {
+        slot_h = head->hashes[i];
+
+        // An empty slot or a slot closer to its home ends the probe sequence
+        if (slot_h == 0 || MHO_MAP_DIST(i, slot_h, mask) < dist)
+            return FALSE;
+
+        if (slot_h == h && head->eq_fn((u8 *)keys + i * head->key_size, key, head->key_size))
+        {
+            head->slot = i;
+            return TRUE;
+        }
+    }
+}
+
+b32
+mho__map_find(mho_map_header_t *head,
+              void *keys,
+              const void *key)
+{
+    if (head->size == 0)
+        return FALSE;
+
+    return mho__map_find_hashed(head, keys, key, mho__map_hash(head, key));
+}
+
+b32
+mho__map_put(mho_map_header_t *head,
+             void **keys,
+             void **vals,
+             void *key,
+             void *val)
+{
+    u32         h;
+
+
+    h = mho__map_hash(head, key);
+    if (mho__map_find_hashed(head, *keys, key, h))
+    {
+        memcpy((u8 *)*vals + head->slot * head->val_size, val, head->val_size);
+        return TRUE;
+    }
+
+    if (head->size + 1 > MHO_MAP_MAX_LOAD(head->capacity))
+    {
+        if (!mho__map_rehash(head, keys, vals, head->capacity ? head->capacity * 2 : MHO_MAP_MIN_CAPACITY))
+            return FALSE;
+    }
+
+    mho__map_insert(head, (u8 *)*keys, (u8 *)*vals, h, (u8 *)key, (u8 *)val);
+
+    return TRUE;
+}
+
+b32
+mho__map_remove(mho_map_header_t *head,
+                void *keys,
+                void *vals,
+                const void *key)
+{
+    u64         mask,
+                i,
+                j;
+    usize       ks = head->key_size,
+                vs = head->val_size;
+
+
+    if (!mho__map_find(head, keys, key))
+        return FALSE;
+
+    // Shift the following entries back by one until one is at its home slot
+    mask = head->capacity - 1;
+    i = head->slot;
+    for (j = (i + 1) & mask; head->hashes[j] && MHO_MAP_DIST(j, head->hashes[j], mask) != 0; j = (j + 1) & mask)
+    {
+        head->hashes[i] = head->hashes[j];
+        memcpy((u8 *)keys + i * ks, (u8 *)keys + j * ks, ks);
+        memcpy((u8 *)vals + i * vs, (u8 *)vals + j * vs, vs);
+        i = j;
+    }
+    head->hashes[i] = 0;
+    head->size--;
+
+    return TRUE;
+}
+
+void
+mho__map_clear(mho_map_header_t *head)
+{
+    if (head->hashes)
+        memset(head->hashes, 0, (usize)head->capacity * sizeof(u32));
+    head->size = 0;
+}
+
+void
+mho__map_free(mho_map_header_t *head)
+{
+    free(head->hashes);
+    free(head);
+}
+
+
+
+//-------------------- SORTING ----------------//
+
+// Below this many keys an insertion sort beats building the histograms
+#define MHO_SORT_INSERTION_MAX      64
+
+// Maps f32 bits to a u32 that sorts in the same order as the float
+#define MHO_F32_TO_KEY(__u) \
+    ((__u) & 0x80000000 ? ~(__u) : (__u) | 0x80000000)
+#define MHO_KEY_TO_F32(__u) \
+    ((__u) & 0x80000000 ? (__u) & 0x7FFFFFFF : ~(__u))
+
+// Sorts keys (and idx, if not NULL) with 8-bit digits. tmp/tmp_idx must have
+// room for n entries. Passes where every key shares the same digit are skipped.
+internal void
+mho__radix_u32(u32 *keys,
+               u32 *tmp,
+               u32 *idx,
+               u32 *tmp_idx,
+               usize n)
+{
+    usize       hist[4][256] = {0},
+                i,
+                j,
+                sum,
+                cnt;
+    u32         *src = keys,
+                *dst = tmp,
+                *src_idx = idx,
+                *dst_idx = tmp_idx,
+                *swap,
+                key,
+                shift,
+                pass;
+
+
+    if (n < MHO_SORT_INSERTION_MAX)
+    {
+        for (i = 1; i < n; i++)
+        {
+            key = keys[i];
+            pass = idx ? idx[i] : 0;
+            for (j = i; j > 0 && keys[j - 1] > key; j--)
+            {
+                keys[j] = keys[j - 1];
+                if (idx)
+                    idx[j] = idx[j - 1];
+            }
+            keys[j] = key;
+            if (idx)
+                idx[j] = pass;
+        }
+        return;
+    }
+
+    // All the histograms are built in a single pass over the keys
+    for (i = 0; i < n; i++)
+    {
+        key = keys[i];
+        hist[0][key & 0xFF]++;
+        hist[1][(key >> 8) & 0xFF]++;
+        hist[2][(key >> 16) & 0xFF]++;
+        hist[3][key >> 24]++;
+    }
+
+    for (pass = 0; pass < 4; pass++)
+    {
+        shift = pass * 8;
+        if (hist[pass][(keys[0] >> shift) & 0xFF] == n)
+            continue;
+
+        for (i = 0, sum = 0; i < 256; i++)
+        {
+            cnt = hist[pass][i];
+            hist[pass][i] = sum;
+            sum += cnt;
+        }
+
+        for (i = 0; i < n; i++)
+        {
+            j = hist[pass][(src[i] >> shift) & 0xFF]++;
+            dst[j] = src[i];
+            if (idx)
+                dst_idx[j] = src_idx[i];
+        }
+
+        swap = src; src = dst; dst = swap;
+        swap = src_idx; src_idx = dst_idx; dst_idx = swap;
+    }
+
+    if (src != keys)
+    {
+        memcpy(keys, src, n * sizeof(u32));
+        if (idx)
+            memcpy(idx, src_idx, n * sizeof(u32));
+    }
+}
+
+internal void
+mho__radix_u64(u64 *keys,
+               u64 *tmp,
+               u32 *idx,
+               u32 *tmp_idx,
+               usize n)
+{
+    usize       hist[8][256] = {0},
+                i,
+                j,
+                sum,
+                cnt;
+    u64         *src = keys,
+                *dst = tmp,
+                *swap,
+                key;
+    u32         *src_idx = idx,
+                *dst_idx = tmp_idx,
+                *swap_idx,
+                shift,
+                pass;
+
+
+    if (n < MHO_SORT_INSERTION_MAX)
+    {
+        for (i = 1; i < n; i++)
+        {
+            key = keys[i];
+            pass = idx ? idx[i] : 0;
+            for (j = i; j > 0 && keys[j - 1] > key; j--)
+            {
+                keys[j] = keys[j - 1];
+                if (idx)
+                    idx[j] = idx[j - 1];
+            }
+            keys[j] = key;
+            if (idx)
+                idx[j] = pass;
+        }
+        return;
+    }
+
+    for (i = 0; i < n; i++)
+    {
+        key = keys[i];
+        for (pass = 0; pass < 8; pass++)
+            hist[pass][(key >> (pass * 8)) & 0xFF]++;
+    }
+
+    for (pass = 0; pass < 8; pass++)
+    {
+        shift = pass * 8;
+        if (hist[pass][(keys[0] >> shift) & 0xFF] == n)
+            continue;
+
+        for (i = 0, sum = 0; i < 256; i++)
+        {
+            cnt = hist[pass][i];
+            hist[pass][i] = sum;
+            sum += cnt;
+        }
+
+        for (i = 0; i < n; i++)
+        {
+            j = hist[pass][(src[i] >> shift) & 0xFF]++;
+            dst[j] = src[i];
+            if (idx)
+                dst_idx[j] = src_idx[i];
+        }
+
+        swap = src; src = dst; dst = swap;
+        swap_idx = src_idx; src_idx = dst_idx; dst_idx = swap_idx;
+    }
+
+    if (src != keys)
+    {
+        memcpy(keys, src, n * sizeof(u64));
+        if (idx)
+            memcpy(idx, src_idx, n * sizeof(u32));
+    }
+}
+
+// Returns a scratch buffer of at least size bytes, from *scratch if given
+internal u8 *
+mho__sort_scratch(mho_arr(u8) *scratch,
+                  mho_arr(u8) *tmp_scratch,
+                  usize size)
+{
+    if (!scratch)
+        scratch = tmp_scratch;
+
+    mho_arr_reserve(*scratch, size);
+    if (*scratch)
+        mho_arr_head(*scratch)->size = size;
+
+    return *scratch;
+}
+
+// Fills idx with 0..n-1
+internal void
+mho__sort_iota(u32 *idx,
+               usize n)
+{
+    usize       i;
+
+
+    for (i = 0; i < n; i++)
+        idx[i] = (u32)i;
+}
+
+// Reorders n items of item_size bytes so that items[i] = old items[idx[i]]
+internal void
+mho__sort_gather(void *items,
+                 void *tmp,
+                 const u32 *idx,
+                 usize item_size,
+                 usize n)
+{
+    usize       i;
+
+
+    for (i = 0; i < n; i++)
+        memcpy((u8 *)tmp + i * item_size, (u8 *)items + (usize)idx[i] * item_size, item_size);
+    memcpy(items, tmp, n * item_size);
+}
+
+void
+mho_sort_u32(u32 *keys,
+             usize n,
+             mho_arr(u8) *scratch)
+{
+    mho_arr(u8)     tmp_scratch = NULL;
+    u8              *tmp;
+
+
+    tmp = mho__sort_scratch(scratch, &tmp_scratch, n * sizeof(u32));
+    if (tmp)
+        mho__radix_u32(keys, (u32 *)tmp, NULL, NULL, n);
+    mho_arr_free(tmp_scratch);
+}
+
+void
+mho_sort_u64(u64 *keys,
+             usize n,
+             mho_arr(u8) *scratch)
+{
+    mho_arr(u8)     tmp_scratch = NULL;
+    u8              *tmp;
+
+
+    tmp = mho__sort_scratch(scratch, &tmp_scratch, n * sizeof(u64));
+    if (tmp)
+        mho__radix_u64(keys, (u64 *)tmp, NULL, NULL, n);
+    mho_arr_free(tmp_scratch);
+}
+
+void
+mho_sort_f32(f32 *keys,
+             usize n,
+             mho_arr(u8) *scratch)
+{
+    u32             *bits = (u32 *)keys;
+    usize           i;
+
+
+    for (i = 0; i < n; i++)
+        bits[i] = MHO_F32_TO_KEY(bits[i]);
+
+    mho_sort_u32(bits, n, scratch);
+
+    for (i = 0; i < n; i++)
+        bits[i] = MHO_KEY_TO_F32(bits[i]);
+}
+
+void
+mho_sort_u32_kv(u32 *keys,
+                void *vals,
+                usize val_size,
+                usize n,
+                mho_arr(u8) *scratch)
+{
+    mho_arr(u8)     tmp_scratch = NULL;
+    u8              *tmp;
+    u32             *idx;
+
+
+    // [tmp keys | idx | tmp idx | tmp vals]
+    tmp = mho__sort_scratch(scratch, &tmp_scratch, n * (sizeof(u32) * 3 + val_size));
+    if (tmp)
+    {
+        idx = (u32 *)tmp + n;
+        mho__sort_iota(idx, n);
+        mho__radix_u32(keys, (u32 *)tmp, idx, idx + n, n);
+        mho__sort_gather(vals, idx + 2 * n, idx, val_size, n);
+    }
+    mho_arr_free(tmp_scratch);
+}
+
+void
+mho_sort_u64_kv(u64 *keys,
+                void *vals,
+                usize val_size,
+                usize n,
+                mho_arr(u8) *scratch)
+{
+    mho_arr(u8)     tmp_scratch = NULL;
+    u8              *tmp;
+    u32             *idx;
+
+
+    // [tmp keys | idx | tmp idx | tmp vals]
+    tmp = mho__sort_scratch(scratch, &tmp_scratch, n * (sizeof(u64) + sizeof(u32) * 2 + val_size));
+    if (tmp)
+    {
+        idx = (u32 *)((u64 *)tmp + n);
+        mho__sort_iota(idx, n);
+        mho__radix_u64(keys, (u64 *)tmp, idx, idx + n, n);
+        mho__sort_gather(vals, idx + 2 * n, idx, val_size, n);
+    }
+    mho_arr_free(tmp_scratch);
+}
+
+void
+mho_sort_f32_kv(f32 *keys,
+                void *vals,
+                usize val_size,
+                usize n,
+                mho_arr(u8) *scratch)
+{
+    u32             *bits = (u32 *)keys;
+    usize           i;
+
+
+    for (i = 0; i < n; i++)
+        bits[i] = MHO_F32_TO_KEY(bits[i]);
+
+    mho_sort_u32_kv(bits, vals, val_size, n, scratch);
+
+    for (i = 0; i < n; i++)
+        bits[i] = MHO_KEY_TO_F32(bits[i]);
+}
+
+void
+mho_sort_by_u32(void *items,
+                usize item_size,
+                usize n,
+                u32 (*key_fn)(const void *item),
+                mho_arr(u8) *scratch)
+{
+    mho_arr(u8)     tmp_scratch = NULL;
+    u8              *tmp;
+    u32             *keys,
+                    *idx;
+    usize           i;
+
+
+    // [keys | tmp keys | idx | tmp idx | tmp items]
+    tmp = mho__sort_scratch(scratch, &tmp_scratch, n * (sizeof(u32) * 4 + item_size));
+    if (tmp)
+    {
+        keys = (u32 *)tmp;
+        idx = keys + 2 * n;
+        for (i = 0; i < n; i++)
+            keys[i] = key_fn((u8 *)items + i * item_size);
+        mho__sort_iota(idx, n);
+        mho__radix_u32(keys, keys + n, idx, idx + n, n);
+        mho__sort_gather(items, idx + 2 * n, idx, item_size, n);
+    }
+    mho_arr_free(tmp_scratch);
+}
+
+void
+mho_sort_by_f32(void *items,
+                usize item_size,
+                usize n,
+                f32 (*key_fn)(const void *item),
+                mho_arr(u8) *scratch)
+{
+    mho_arr(u8)     tmp_scratch = NULL;
+    u8              *tmp;
+    u32             *keys,
+                    *idx,
+                    bits;
+    usize           i;
+    f32             key;
+
+
+    // [keys | tmp keys | idx | tmp idx | tmp items]
+    tmp = mho__sort_scratch(scratch, &tmp_scratch, n * (sizeof(u32) * 4 + item_size));
+    if (tmp)
+    {
+        keys = (u32 *)tmp;
+        idx = keys + 2 * n;
+        for (i = 0; i < n; i++)
+        {
+            key = key_fn((u8 *)items + i * item_size);
+            memcpy(&bits, &key, sizeof(u32));
+            keys[i] = MHO_F32_TO_KEY(bits);
+        }
+        mho__sort_iota(idx, n);
+        mho__radix_u32(keys, keys + n, idx, idx + n, n);
+        mho__sort_gather(items, idx + 2 * n, idx, item_size, n);
+    }
+    mho_arr_free(tmp_scratch);
+}
+
+usize
+mho_lower_bound_u32(const u32 *keys,
+                    usize n,
+                    u32 key)
+{
+    usize       lo = 0,
+                mid;
+
+
+    while (n > 0)
+    {
+        mid = n / 2;
+        if (keys[lo + mid] < key)
+        {
+            lo += mid + 1;
+            n -= mid + 1;
+        }
+        else
+        {
+            n = mid;
+        }
+    }
+
+    return lo;
+}
+
+usize
+mho_lower_bound_u64(const u64 *keys,
+                    usize n,
+                    u64 key)
+{
+    usize       lo = 0,
+                mid;
+
+
+    while (n > 0)
+    {
+        mid = n / 2;
+        if (keys[lo + mid] < key)
+        {
+            lo += mid + 1;
+            n -= mid + 1;
+        }
+        else
+        {
+            n = mid;
+        }
+    }
+
+    return lo;
+}
+
+usize
+mho_lower_bound_f32(const f32 *keys,
+                    usize n,
+                    f32 key)
+{
+    usize       lo = 0,
+                mid;
+
+
+    while (n > 0)
+    {
+        mid = n / 2;
+        if (keys[lo + mid] < key)
+        {
+            lo += mid + 1;
+            n -= mid + 1;
+        }
+        else
+        {
+            n = mid;
+        }
+    }
+
+    return lo;
+}
+
+usize
+mho_upper_bound_u32(const u32 *keys,
+                    usize n,
+                    u32 key)
+{
+    usize       lo = 0,
+                mid;
+
+
+    while (n > 0)
+    {
+        mid = n / 2;
+        if (keys[lo + mid] <= key)
+        {
+            lo += mid + 1;
+            n -= mid + 1;
+        }
+        else
+        {
+            n = mid;
+        }
+    }
+
+    return lo;
+}
+
+usize
+mho_upper_bound_u64(const u64 *keys,
+                    usize n,
+                    u64 key)
+{
+    usize       lo = 0,
+                mid;
+
+
+    while (n > 0)
+    {
+        mid = n / 2;
+        if (keys[lo + mid] <= key)
+        {
+            lo += mid + 1;
+            n -= mid + 1;
+        }
+        else
+        {
+            n = mid;
+        }
+    }
+
+    return lo;
+}
+
+usize
+mho_upper_bound_f32(const f32 *keys,
+                    usize n,
+                    f32 key)
+{
+    usize       lo = 0,
+                mid;
+
+
+    while (n > 0)
+    {
+        mid = n / 2;
+        if (keys[lo + mid] <= key)
+        {
+            lo += mid + 1;
+            n -= mid + 1;
+        }
+        else
+        {
+            n = mid;
+        }
+    }
+
+    return lo;
+}
+
+
+
+//-------------------- OBJECT POOL ----------------//
+
+#define MHO_POOL_HANDLE(__slot, __gen) \
+    ((mho_handle_t)(((__gen) << MHO_POOL_INDEX_BITS) | (__slot)))
+
+void *
+mho__pool_create(usize pool_size,
+                 usize val_size)
+{
+    mho_pool_header_t   *head;
+
+
+    head = (mho_pool_header_t *)calloc(1, pool_size);
+    if (head)
+    {
+        head->free_head = U32_MAX;
+        head->val_size = val_size;
+    }
+
+    return head;
+}
+
+mho_handle_t
+mho__pool_add(mho_pool_header_t *head,
+              void **data,
+              const void *val)
+{
+    u32         slot,
+                index;
+
+
+    index = (u32)mho_arr_size(*data);
+
+    // Reuse a destroyed slot, or append a new one (generations start at 1)
+    if (head->free_head != U32_MAX)
+    {
+        slot = head->free_head;
+        head->free_head = head->sparse[slot];
+    }
+    else
+    {
+        slot = (u32)mho_arr_size(head->sparse);
+        if (slot > MHO_POOL_INDEX_MASK)
+            return 0;
+
+        mho_arr_push(head->sparse, 0);
+        mho_arr_push(head->gens, 1);
+    }
+
+    *data = mho__arr_insert_n(*data, head->val_size, index, val, 1);
+    mho_arr_push(head->handles, MHO_POOL_HANDLE(slot, head->gens[slot]));
+    head->sparse[slot] = index;
+
+    return MHO_POOL_HANDLE(slot, head->gens[slot]);
+}
+
+b32
+mho__pool_find(mho_pool_header_t *head,
+               mho_handle_t handle)
+{
+    u32         slot = handle & MHO_POOL_INDEX_MASK,
+                index;
+
+
+    // A slot's generation is bumped when it is destroyed, so stale handles
+    // never match
+    if (slot >= mho_arr_size(head->gens) || head->gens[slot] != (handle >> MHO_POOL_INDEX_BITS))
+        return FALSE;
+
+    // A free slot already carries its next generation (and its sparse entry
+    // is a free list link), so the dense side has to point back at the handle
+    index = head->sparse[slot];
+    if (index >= mho_arr_size(head->handles) || head->handles[index] != handle)
+        return FALSE;
+
+    head->found = index;
+
+    return TRUE;
+}
+
+b32
+mho__pool_remove(mho_pool_header_t *head,
+                 void *data,
+                 mho_handle_t handle)
+{
+    u32         slot = handle & MHO_POOL_INDEX_MASK,
+                index,
+                last;
+
+
+    if (!mho__pool_find(head, handle))
+        return FALSE;
+
+    // Move the last element into the hole
+    index = head->found;
+    last = (u32)mho_arr_size(data) - 1;
+    if (index != last)
+    {
+        memcpy((u8 *)data + (usize)index * head->val_size, (u8 *)data + (usize)last * head->val_size, head->val_size);
+        head->handles[index] = head->handles[last];
+        head->sparse[head->handles[index] & MHO_POOL_INDEX_MASK] = index;
+    }
+    mho_arr_head(data)->size--;
+    mho_arr_head(head->handles)->size--;
+
+    // Retire the slot (generation 0 is skipped so handles are never 0)
+    head->gens[slot] = (head->gens[slot] + 1) & MHO_POOL_GEN_MASK;
+    if (head->gens[slot] == 0)
+        head->gens[slot] = 1;
+    head->sparse[slot] = head->free_head;
+    head->free_head = slot;
+
+    return TRUE;
+}
+
+void
+mho__pool_clear(mho_pool_header_t *head,
+                void *data)
+{
+    // Removing from the back never moves any elements
+    while (mho_arr_size(head->handles) > 0)
+        mho__pool_remove(head, data, head->handles[mho_arr_size(head->handles) - 1]);
+}
+
+void
+mho__pool_free(mho_pool_header_t *head,
+               void *data)
+{
+    mho_arr_free(head->sparse);
+    mho_arr_free(head->gens);
+    mho_arr_free(head->handles);
+    mho__arr_free(data, head->val_size);
+    free(head);
+}
+
+
+
+//-------------------- RING BUFFERS ----------------//
+
+struct _TAG_mho_spsc
+{
+    u8                  pad0[MHO_CACHE_LINE];
+    mho__atomic_usize   head;           // Next element to pop (written by the consumer)
+    usize               tail_cache;     // Consumer's last view of tail
+    u8                  pad1[MHO_CACHE_LINE - sizeof(mho__atomic_usize) - sizeof(usize)];
+    mho__atomic_usize   tail;           // Next element to push (written by the producer)
+    usize               head_cache;     // Producer's last view of head
+    u8                  pad2[MHO_CACHE_LINE - sizeof(mho__atomic_usize) - sizeof(usize)];
+    usize               mask,
+                        elem_size;
+    mho_arr(u8)         data;
+};
+
+struct _TAG_mho_mpmc
+{
+    u8                  pad0[MHO_CACHE_LINE];
+    mho__atomic_usize   enqueue_pos;
+    u8                  pad1[MHO_CACHE_LINE - sizeof(mho__atomic_usize)];
+    mho__atomic_usize   dequeue_pos;
+    u8                  pad2[MHO_CACHE_LINE - sizeof(mho__atomic_usize)];
+    usize               mask,
+                        elem_size,
+                        stride;         // Bytes per cell (sequence number + element)
+    mho_arr(u8)         cells;
+};
+
+// Rounds a capacity up to a power of 2 (at least 2)
+internal usize
+mho__ring_capacity(usize capacity)
+{
+    usize       cap = 2;
+
+
+    while (cap < capacity)
+        cap <<= 1;
+
+    return cap;
+}
+
+// Copies n elements into the ring starting at position pos (handles wrapping)
+internal void
+mho__ring_write(u8 *data,
+                usize mask,
+                usize elem_size,
+                usize pos,
+                const u8 *src,
+                usize n)
+{
+    usize       idx = pos & mask,
+                first = mho_min(n, mask + 1 - idx);
+
+
+    memcpy(data + idx * elem_size, src, first * elem_size);
+    memcpy(data, src + first * elem_size, (n - first) * elem_size);
+}
+
+// Copies n elements out of the ring starting at position pos (handles wrapping)
+internal void
+mho__ring_read(const u8 *data,
+               usize mask,
+               usize elem_size,
+               usize pos,
+               u8 *dst,
+               usize n)
+{
+    usize       idx = pos & mask,
+                first = mho_min(n, mask + 1 - idx);
+
+
+    memcpy(dst, data + idx * elem_size, first * elem_size);
+    memcpy(dst + first * elem_size, data, (n - first) * elem_size);
+}
+
+mho_spsc_t *
+mho_spsc_create(usize elem_size,
+                usize capacity)
+{
+    mho_spsc_t      *queue;
+
+
+    queue = (mho_spsc_t *)calloc(1, sizeof(mho_spsc_t));
+    if (queue)
+    {
+        capacity = mho__ring_capacity(capacity);
+        queue->data = (u8 *)mho__arr_create(elem_size, capacity, MHO_CACHE_LINE, NULL);
+        if (!queue->data)
+        {
+            free(queue);
+            return NULL;
+        }
+
+        mho__atomic_init(&queue->head, 0);
+        mho__atomic_init(&queue->tail, 0);
+        queue->mask = capacity - 1;
+        queue->elem_size = elem_size;
+    }
+
+    return queue;
+}
+
+void
+mho_spsc_destroy(mho_spsc_t *queue)
+{
+    if (queue)
+    {
+        mho__arr_free(queue->data, queue->elem_size);
+        free(queue);
+    }
+}
+
+usize
+mho_spsc_push_n(mho_spsc_t *queue,
+                const void *elems,
+                usize n)
+{
+    usize       tail,
+                space;
+
+
+    tail = mho__atomic_load(&queue->tail);
+
+    // Only look at the consumer's index when the cached one says we're full
+    space = queue->mask + 1 - (tail - queue->head_cache);
+    if (space < n)
+    {
+        queue->head_cache = mho__atomic_load_acquire(&queue->head);
+        space = queue->mask + 1 - (tail - queue->head_cache);
+    }
+
+    n = mho_min(n, space);
+    if (n)
+    {
+        mho__ring_write(queue->data, queue->mask, queue->elem_size, tail, (const u8 *)elems, n);
+        mho__atomic_store_release(&queue->tail, tail + n);
+    }
+
+    return n;
+}
+
+usize
+mho_spsc_pop_n(mho_spsc_t *queue,
+               void *elems,
+               usize n)
+{
+    usize       head,
+                avail;
+
+
+    head = mho__atomic_load(&queue->head);
+
+    // Only look at the producer's index when the cached one says we're empty
+    avail = queue->tail_cache - head;
+    if (avail < n)
+    {
+        queue->tail_cache = mho__atomic_load_acquire(&queue->tail);
+        avail = queue->tail_cache - head;
+    }
+
+    n = mho_min(n, avail);
+    if (n)
+    {
+        mho__ring_read(queue->data, queue->mask, queue->elem_size, head, (u8 *)elems, n);
+        mho__atomic_store_release(&queue->head, head + n);
+    }
+
+    return n;
+}
+
+b32
+mho_spsc_push(mho_spsc_t *queue,
+              const void *elem)
+{
+    return mho_spsc_push_n(queue, elem, 1) == 1;
+}
+
+b32
+mho_spsc_pop(mho_spsc_t *queue,
+             void *elem)
+{
+    return mho_spsc_pop_n(queue, elem, 1) == 1;
+}
+
+usize
+mho_spsc_size(mho_spsc_t *queue)
+{
+    usize       head;
+
+
+    head = mho__atomic_load_acquire(&queue->head);
+
+    return mho__atomic_load_acquire(&queue->tail) - head;
+}
+
+#define MHO_MPMC_CELL(__queue, __pos) \
+    ((__queue)->cells + ((__pos) & (__queue)->mask) * (__queue)->stride)
+
+#define MHO_MPMC_SEQ(__cell) \
+    ((mho__atomic_usize *)(__cell))
+
+#define MHO_MPMC_DATA(__cell) \
+    ((__cell) + sizeof(mho__atomic_usize))
+
+mho_mpmc_t *
+mho_mpmc_create(usize elem_size,
+                usize capacity)
+{
+    mho_mpmc_t      *queue;
+    usize           i;
+
+
+    queue = (mho_mpmc_t *)calloc(1, sizeof(mho_mpmc_t));
+    if (queue)
+    {
+        capacity = mho__ring_capacity(capacity);
+        queue->stride = MHO_ALIGN_UP(sizeof(mho__atomic_usize) + elem_size, sizeof(mho__atomic_usize));
+        queue->cells = (u8 *)mho__arr_create(queue->stride, capacity, MHO_CACHE_LINE, NULL);
+        if (!queue->cells)
+        {
+            free(queue);
+            return NULL;
+        }
+
+        // Cell i is free for the producer at position i
+        for (i = 0; i < capacity; i++)
+            mho__atomic_init(MHO_MPMC_SEQ(queue->cells + i * queue->stride), i);
+
+        mho__atomic_init(&queue->enqueue_pos, 0);
+        mho__atomic_init(&queue->dequeue_pos, 0);
+        queue->mask = capacity - 1;
+        queue->elem_size = elem_size;
+    }
+
+    return queue;
+}
+
+void
+mho_mpmc_destroy(mho_mpmc_t *queue)
+{
+    if (queue)
+    {
+        mho__arr_free(queue->cells, queue->stride);
+        free(queue);
+    }
+}
+
+usize
+mho_mpmc_push_n(mho_mpmc_t *queue,
+                const void *elems,
+                usize n)
+{
+    usize       pos,
+                seq = 0,
+                k,
+                i;
+    u8          *cell;
+
+
+    if (n == 0)
+        return 0;
+
+    pos = mho__atomic_load(&queue->enqueue_pos);
+    for (;;)
+    {
+        // Count the free cells from pos on (a free cell's sequence == its position)
+        for (k = 0; k < n && k <= queue->mask; k++)
+        {
+            seq = mho__atomic_load_acquire(MHO_MPMC_SEQ(MHO_MPMC_CELL(queue, pos + k)));
+            if (seq != pos + k)
+                break;
+        }
+
+        if (k == 0)
+        {
+            // Cell still holds an element from the previous lap: full
+            if ((intptr_t)(seq - pos) < 0)
+                return 0;
+
+            // Another producer got there first
+            pos = mho__atomic_load(&queue->enqueue_pos);
+        }
+        else if (mho__atomic_cas(&queue->enqueue_pos, &pos, pos + k))
+        {
+            break;
+        }
+    }
+
+    // The cells are ours, fill them and hand them to the consumers
+    for (i = 0; i < k; i++)
+    {
+        cell = MHO_MPMC_CELL(queue, pos + i);
+        memcpy(MHO_MPMC_DATA(cell), (const u8 *)elems + i * queue->elem_size, queue->elem_size);
+        mho__atomic_store_release(MHO_MPMC_SEQ(cell), pos + i + 1);
+    }
+
+    return k;
+}
+
+usize
+mho_mpmc_pop_n(mho_mpmc_t *queue,
+               void *elems,
+               usize n)
+{
+    usize       pos,
+                seq = 0,
+                k,
+                i;
+    u8          *cell;
+
+
+    if (n == 0)
+        return 0;
+
+    pos = mho__atomic_load(&queue->dequeue_pos);
+    for (;;)
+    {
+        // Count the full cells from pos on (a full cell's sequence == its position + 1)
+        for (k = 0; k < n && k <= queue->mask; k++)
+        {
+            seq = mho__atomic_load_acquire(MHO_MPMC_SEQ(MHO_MPMC_CELL(queue, pos + k)));
+            if (seq != pos + k + 1)
+                break;
+        }
+
+        if (k == 0)
+        {
+            // Cell hasn't been filled yet: empty
+            if ((intptr_t)(seq - (pos + 1)) < 0)
+                return 0;
+
+            // Another consumer got there first
+            pos = mho__atomic_load(&queue->dequeue_pos);
+        }
+        else if (mho__atomic_cas(&queue->dequeue_pos, &pos, pos + k))
+        {
+            break;
+        }
+    }
+
+    // The cells are ours, empty them and hand them back to the producers
+    for (i = 0; i < k; i++)
+    {
+        cell = MHO_MPMC_CELL(queue, pos + i);
+        memcpy((u8 *)elems + i * queue->elem_size, MHO_MPMC_DATA(cell), queue->elem_size);
+        mho__atomic_store_release(MHO_MPMC_SEQ(cell), pos + i + queue->mask + 1);
+    }
+
+    return k;
+}
+
+b32
+mho_mpmc_push(mho_mpmc_t *queue,
+              const void *elem)
+{
+    return mho_mpmc_push_n(queue, elem, 1) == 1;
+}
+
+b32
+mho_mpmc_pop(mho_mpmc_t *queue,
+             void *elem)
+{
+    return mho_mpmc_pop_n(queue, elem, 1) == 1;
+}
+
+usize
+mho_mpmc_size(mho_mpmc_t *queue)
+{
+    usize       head,
+                tail;
+
+
+    head = mho__atomic_load_acquire(&queue->dequeue_pos);
+    tail = mho__atomic_load_acquire(&queue->enqueue_pos);
+
+    return tail > head ? tail - head : 0;
+}
+
+
+
+//-------------------- STRINGS ----------------//
+
+// Smallest heap capacity a string builder grows to
+#define MHO_STRBUF_MIN_CAPACITY     64
+
+mho_str_t
+mho_str(const char *cstr)
+{
+    return mho_str_n(cstr, cstr ? strlen(cstr) : 0);
+}
+
+mho_str_t
+mho_str_n(const char *ptr,
+          usize len)
+{
+    mho_str_t       str;
+
+
+    str.ptr = ptr;
+    str.len = len;
+
+    return str;
+}
+
+mho_str_t
+mho_str_sub(mho_str_t str,
+            usize pos,
+            usize len)
+{
+    pos = mho_min(pos, str.len);
+    len = mho_min(len, str.len - pos);
+
+    return mho_str_n(str.ptr + pos, len);
+}
+
+b32
+mho_str_eq(mho_str_t a,
+           mho_str_t b)
+{
+    return a.len == b.len && memcmp(a.ptr, b.ptr, a.len) == 0;
+}
+
+b32
+mho_str_starts_with(mho_str_t str,
+                    mho_str_t prefix)
+{
+    return str.len >= prefix.len && memcmp(str.ptr, prefix.ptr, prefix.len) == 0;
+}
+
+void
+mho_strbuf_init(mho_strbuf_t *sb,
+                char *storage,
+                usize size)
+{
+    sb->len = 0;
+    sb->owns_ptr = FALSE;
+    if (storage && size > 0)
+    {
+        sb->ptr = storage;
+        sb->cap = size - 1;
+        sb->ptr[0] = 0;
+    }
+    else
+    {
+        sb->ptr = NULL;
+        sb->cap = 0;
+    }
+}
+
+void
+mho_strbuf_free(mho_strbuf_t *sb)
+{
+    if (sb->owns_ptr)
+        free(sb->ptr);
+
+    sb->ptr = NULL;
+    sb->len = 0;
+    sb->cap = 0;
+    sb->owns_ptr = FALSE;
+}
+
+b32
+mho_strbuf_reserve(mho_strbuf_t *sb,
+                   usize n)
+{
+    usize       cap;
+    char        *ptr;
+
+
+    if (sb->ptr && sb->len + n <= sb->cap)
+        return TRUE;
+
+    cap = mho_max(sb->cap * 2, sb->len + n);
+    cap = mho_max(cap, MHO_STRBUF_MIN_CAPACITY);
+
+    // Caller storage is copied over to the heap the first time it overflows
+    if (sb->owns_ptr)
+    {
+        ptr = (char *)realloc(sb->ptr, cap + 1);
+    }
+    else
+    {
+        ptr = (char *)malloc(cap + 1);
+        if (ptr)
+            memcpy(ptr, sb->ptr ? sb->ptr : "", sb->len + 1);
+    }
+
+    if (!ptr)
+        return FALSE;
+
+    sb->ptr = ptr;
+    sb->cap = cap;
+    sb->owns_ptr = TRUE;
+
+    return TRUE;
+}
+
+void
+mho_strbuf_clear(mho_strbuf_t *sb)
+{
+    sb->len = 0;
+    if (sb->ptr)
+        sb->ptr[0] = 0;
+}
+
+b32
+mho_strbuf_append(mho_strbuf_t *sb,
+                  mho_str_t str)
+{
+    if (!mho_strbuf_reserve(sb, str.len))
+        return FALSE;
+
+    memcpy(sb->ptr + sb->len, str.ptr, str.len);
+    sb->len += str.len;
+    sb->ptr[sb->len] = 0;
+
+    return TRUE;
+}
+
+b32
+mho_strbuf_append_cstr(mho_strbuf_t *sb,
+                       const char *cstr)
+{
+    return mho_strbuf_append(sb, mho_str(cstr));
+}
+
+b32
+mho_strbuf_append_char(mho_strbuf_t *sb,
+                       char c)
+{
+    if (!mho_strbuf_reserve(sb, 1))
+        return FALSE;
+
+    sb->ptr[sb->len++] = c;
+    sb->ptr[sb->len] = 0;
+
+    return TRUE;
+}
+
+b32
+mho_strbuf_appendf(mho_strbuf_t *sb,
+                   const char *fmt,
+                   ...)
+{
+    va_list     args;
+    s32         n;
+    usize       avail;
+
+
+    // Format straight into the free space, and only retry if it didn't fit
+    avail = sb->ptr ? sb->cap - sb->len + 1 : 0;
+    va_start(args, fmt);
+    n = vsnprintf(avail ? sb->ptr + sb->len : NULL, avail, fmt, args);
+    va_end(args);
+    if (n < 0)
+        return FALSE;
+
+    if ((usize)n >= avail)
+    {
+        if (!mho_strbuf_reserve(sb, (usize)n))
+            return FALSE;
+
+        va_start(args, fmt);
+        vsnprintf(sb->ptr + sb->len, (usize)n + 1, fmt, args);
+        va_end(args);
+    }
+    sb->len += (usize)n;
+
+    return TRUE;
+}
+
+mho_str_t
+mho_strbuf_str(const mho_strbuf_t *sb)
+{
+    return mho_str_n(sb->ptr ? sb->ptr : "", sb->len);
+}
+
+
+
+//-------------------- THREADING ----------------//
+
+// Minimal wrappers over the platform's threading primitives, for internal use
+
+#if defined(_WIN32) || defined(_WIN64)
+    typedef SRWLOCK             mho__rwlock_t;
+
+    #define mho__rwlock_init(__l)       InitializeSRWLock(__l)
+    #define mho__rwlock_destroy(__l)    ((void)(__l))
+    #define mho__rwlock_rdlock(__l)     AcquireSRWLockShared(__l)
+    #define mho__rwlock_rdunlock(__l)   ReleaseSRWLockShared(__l)
+    #define mho__rwlock_wrlock(__l)     AcquireSRWLockExclusive(__l)
+    #define mho__rwlock_wrunlock(__l)   ReleaseSRWLockExclusive(__l)
+
+    typedef HANDLE              mho__thread_t;
+    typedef SRWLOCK             mho__mutex_t;
+    typedef CONDITION_VARIABLE  mho__cond_t;
+    typedef DWORD               (WINAPI *mho__thread_proc_t)(LPVOID);
+
+    // Declares a thread entry point, which must end with MHO__THREAD_RETURN
+    #define MHO__THREAD_PROC(__name, __arg)     DWORD WINAPI __name(LPVOID __arg)
+    #define MHO__THREAD_RETURN                  return 0
+
+    #define mho__thread_create(__t, __fn, __arg) \
+        ((*(__t) = CreateThread(NULL, 0, (__fn), (__arg), 0, NULL)) != NULL)
+    #define mho__thread_join(__t) \
+        (WaitForSingleObject((__t), INFINITE), CloseHandle(__t))
+
+    #define mho__mutex_init(__m)        InitializeSRWLock(__m)
+    #define mho__mutex_destroy(__m)     ((void)(__m))
+    #define mho__mutex_lock(__m)        AcquireSRWLockExclusive(__m)
+    #define mho__mutex_unlock(__m)      ReleaseSRWLockExclusive(__m)
+
+    #define mho__cond_init(__c)         InitializeConditionVariable(__c)
+    #define mho__cond_destroy(__c)      ((void)(__c))
+    #define mho__cond_wait(__c, __m)    SleepConditionVariableSRW((__c), (__m), INFINITE, 0)
+    #define mho__cond_signal(__c)       WakeConditionVariable(__c)
+    #define mho__cond_broadcast(__c)    WakeAllConditionVariable(__c)
+#else
+    typedef pthread_rwlock_t    mho__rwlock_t;
+
+    #define mho__rwlock_init(__l)       pthread_rwlock_init((__l), NULL)
+    #define mho__rwlock_destroy(__l)    pthread_rwlock_destroy(__l)
+    #define mho__rwlock_rdlock(__l)     pthread_rwlock_rdlock(__l)
+    #define mho__rwlock_rdunlock(__l)   pthread_rwlock_unlock(__l)
+    #define mho__rwlock_wrlock(__l)     pthread_rwlock_wrlock(__l)
+    #define mho__rwlock_wrunlock(__l)   pthread_rwlock_unlock(__l)
+
+    typedef pthread_t           mho__thread_t;
+    typedef pthread_mutex_t     mho__mutex_t;
+    typedef pthread_cond_t      mho__cond_t;
+    typedef void                *(*mho__thread_proc_t)(void *);
+
+    // Declares a thread entry point, which must end with MHO__THREAD_RETURN
+    #define MHO__THREAD_PROC(__name, __arg)     void *__name(void *__arg)
+    #define MHO__THREAD_RETURN                  return NULL
+
+    #define mho__thread_create(__t, __fn, __arg) \
+        (pthread_create((__t), NULL, (__fn), (__arg)) == 0)
+    #define mho__thread_join(__t)       pthread_join((__t), NULL)
+
+    #define mho__mutex_init(__m)        pthread_mutex_init((__m), NULL)
+    #define mho__mutex_destroy(__m)     pthread_mutex_destroy(__m)
+    #define mho__mutex_lock(__m)        pthread_mutex_lock(__m)
+    #define mho__mutex_unlock(__m)      pthread_mutex_unlock(__m)
+
+    #define mho__cond_init(__c)         pthread_cond_init((__c), NULL)
+    #define mho__cond_destroy(__c)      pthread_cond_destroy(__c)
+    #define mho__cond_wait(__c, __m)    pthread_cond_wait((__c), (__m))
+    #define mho__cond_signal(__c)       pthread_cond_signal(__c)
+    #define mho__cond_broadcast(__c)    pthread_cond_broadcast(__c)
+#endif
+
+// Returns a monotonic timestamp in seconds
+internal f64
+mho__now(void)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    LARGE_INTEGER       freq,
+                        counter;
+
+
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&counter);
+
+    return (f64)counter.QuadPart / (f64)freq.QuadPart;
+#else
+    struct timespec     ts;
+
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (f64)ts.tv_sec + (f64)ts.tv_nsec * 1e-9;
+#endif
+}
+
+// Returns the number of online logical processors
+internal u32
+mho__cpu_count(void)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    SYSTEM_INFO         info;
+
+
+    GetSystemInfo(&info);
+
+    return info.dwNumberOfProcessors ? (u32)info.dwNumberOfProcessors : 1;
+#else
+    long                n;
+
+
+    n = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return n > 0 ? (u32)n : 1;
+#endif
+}
+
+// Runs proc(ctx) on thread_cnt threads, counting the calling thread, and
+// waits for all of them. Threads that fail to start are skipped, so proc
+// must pull its work from ctx rather than assume a fixed split.
+internal void
+mho__run_threads(mho__thread_proc_t proc,
+                 void *ctx,
+                 u32 thread_cnt)
+{
+    mho__thread_t       *threads;
+    u32                 i,
+                        started = 0;
+
+
+    threads = thread_cnt > 1 ? (mho__thread_t *)malloc((thread_cnt - 1) * sizeof(mho__thread_t)) : NULL;
+    if (threads)
+    {
+        for (i = 0; i < thread_cnt - 1; i++)
+        {
+            if (mho__thread_create(&threads[started], proc, ctx))
+                started++;
+        }
+    }
+
+    proc(ctx);
+
+    for (i = 0; i < started; i++)
+        mho__thread_join(threads[i]);
+    free(threads);
+}
+
+//-------------------- INTERNING ----------------//
+
+#define MHO_INTERN_MIN_CAPACITY     64
+
+// Interned string (the hash is kept so the table can grow without rehashing)
+typedef struct _TAG_mho_intern_entry
+{
+    const char          *ptr;
+    usize               len;
+    u64                 hash;
+} mho_intern_entry_t;
+
+struct _TAG_mho_intern
+{
+    mho__rwlock_t               lock;
+    mho_bump_t                  strings;    // Storage for the string bytes
+    mho_arr(mho_intern_entry_t) entries;    // Entry of each ID (ID - 1)
+    u32                         *slots;     // Open addressing table of IDs (0 = empty)
+    u64                         capacity;
+};
+
+mho_intern_t *
+mho_intern_create(void)
+{
+    mho_intern_t    *table;
+
+
+    table = (mho_intern_t *)calloc(1, sizeof(mho_intern_t));
+    if (table)
+    {
+        mho__rwlock_init(&table->lock);
+        mho_bump_init(&table->strings, 16 * 1024);
+    }
+
+    return table;
+}
+
+void
+mho_intern_destroy(mho_intern_t *table)
+{
+    if (table)
+    {
+        mho__rwlock_destroy(&table->lock);
+        mho_bump_destroy(&table->strings);
+        mho_arr_free(table->entries);
+        free(table->slots);
+        free(table);
+    }
+}
+
+// Linear probe for a string, returns its slot (which is empty if it isn't there)
+internal u64
+mho__intern_probe(mho_intern_t *table,
+                  const char *str,
+                  usize len,
+                  u64 hash)
+{
+    u64                 mask = table->capacity - 1,
+                        i;
+    mho_intern_entry_t  *entry;
+
+
+    for (i = hash & mask; table->slots[i]; i = (i + 1) & mask)
+    {
+        entry = &table->entries[table->slots[i] - 1];
+        if (entry->hash == hash && entry->len == len && memcmp(entry->ptr, str, len) == 0)
+            break;
+    }
+
+    return i;
+}
+
+// Grows the slot table (the caller holds the write lock)
+internal b32
+mho__intern_grow(mho_intern_t *table)
+{
+    u64                 capacity,
+                        mask,
+                        i,
+                        j;
+    u32                 *slots;
+
+
+    capacity = table->capacity ? table->capacity * 2 : MHO_INTERN_MIN_CAPACITY;
+    slots = (u32 *)calloc((usize)capacity, sizeof(u32));
+    if (!slots)
+        return FALSE;
+
+    mask = capacity - 1;
+    for (i = 0; i < mho_arr_size(table->entries); i++)
+    {
+        for (j = table->entries[i].hash & mask; slots[j]; j = (j + 1) & mask)
+            ;
+        slots[j] = (u32)(i + 1);
+    }
+
+    free(table->slots);
+    table->slots = slots;
+    table->capacity = capacity;
+
+    return TRUE;
+}
+
+u32
+mho_intern_find(mho_intern_t *table,
+                const char *str,
+                usize len)
+{
+    u64         hash;
+    u32         id = 0;
+
+
+    hash = mho_map_hash_bytes(str, len);
+
+    mho__rwlock_rdlock(&table->lock);
+    if (table->capacity)
+        id = table->slots[mho__intern_probe(table, str, len, hash)];
+    mho__rwlock_rdunlock(&table->lock);
+
+    return id;
+}
+
+u32
+mho_intern_n(mho_intern_t *table,
+             const char *str,
+             usize len)
+{
+    mho_intern_entry_t  entry;
+    u64                 hash,
+                        slot;
+    u32                 id;
+    char                *copy;
+
+
+    id = mho_intern_find(table, str, len);
+    if (id)
+        return id;
+
+    hash = mho_map_hash_bytes(str, len);
+
+    mho__rwlock_wrlock(&table->lock);
+
+    // Keep the load factor under 1/2
+    if ((mho_arr_size(table->entries) + 1) * 2 > table->capacity && !mho__intern_grow(table))
+    {
+        mho__rwlock_wrunlock(&table->lock);
+        return 0;
+    }
+
+    // Another thread may have added it between the two locks
+    slot = mho__intern_probe(table, str, len, hash);
+    id = table->slots[slot];
+    if (!id)
+    {
+        copy = (char *)mho_bump_alloc(&table->strings, len + 1);
+        if (copy)
+        {
+            memcpy(copy, str, len);
+            copy[len] = 0;
+
+            entry.ptr = copy;
+            entry.len = len;
+            entry.hash = hash;
+            mho_arr_push(table->entries, entry);
+
+            id = (u32)mho_arr_size(table->entries);
+            table->slots[slot] = id;
+        }
+    }
+    mho__rwlock_wrunlock(&table->lock);
+
+    return id;
+}
+
+u32
+mho_intern(mho_intern_t *table,
+           const char *str)
+{
+    return str ? mho_intern_n(table, str, strlen(str)) : 0;
+}
+
+const char *
+mho_intern_str(mho_intern_t *table,
+               u32 id)
+{
+    const char      *str = "";
+
+
+    mho__rwlock_rdlock(&table->lock);
+    if (id > 0 && id <= mho_arr_size(table->entries))
+        str = table->entries[id - 1].ptr;
+    mho__rwlock_rdunlock(&table->lock);
+
+    return str;
+}
+
+usize
+mho_intern_len(mho_intern_t *table,
+               u32 id)
+{
+    usize           len = 0;
+
+
+    mho__rwlock_rdlock(&table->lock);
+    if (id > 0 && id <= mho_arr_size(table->entries))
+        len = table->entries[id - 1].len;
+    mho__rwlock_rdunlock(&table->lock);
+
+    return len;
+}
+
+u32
+mho_intern_count(mho_intern_t *table)
+{
+    u32             count;
+
+
+    mho__rwlock_rdlock(&table->lock);
+    count = (u32)mho_arr_size(table->entries);
+    mho__rwlock_rdunlock(&table->lock);
+
+    return count;
+}
+
+//-------------------- STREAMING ----------------//
+
+#define MHO_STREAM_MIN_DEPTH    2
+#define MHO_STREAM_CHUNK_SIZE   (1024 * 1024)
+
+// Chunks live in a ring of depth slots. The reader thread fills slots at
+// head, the consumer takes them at tail, and the slot last handed out stays
+// untouched until the following mho_stream_next call gives it back.
+struct _TAG_mho_stream
+{
+    FILE                *file;
+    u8                  *buffer;        // depth * chunk_size bytes
+    usize               *lens;          // Bytes in each slot
+    usize               chunk_size;
+    u32                 depth,
+                        head,           // Next slot to fill
+                        tail,           // Next slot to hand out
+                        count;          // Filled slots, including the held one
+    b32                 held,           // Consumer is holding a slot
+                        eof,
+                        error,
+                        stop;
+    mho__mutex_t        lock;
+    mho__cond_t         filled,
+                        drained;
+    mho__thread_t       thread;
+
+    u64                 bytes,
+                        chunks;
+    f64                 start,
+                        stall,
+                        io;
+};
+
+internal
+MHO__THREAD_PROC(mho__stream_proc, arg)
+{
+    mho_stream_t        *stream = (mho_stream_t *)arg;
+    u8                  *dst;
+    usize               len;
+    f64                 t;
+
+
+    for (;;)
+    {
+        mho__mutex_lock(&stream->lock);
+        while (stream->count == stream->depth && !stream->stop)
+            mho__cond_wait(&stream->drained, &stream->lock);
+        if (stream->stop)
+        {
+            mho__mutex_unlock(&stream->lock);
+            break;
+        }
+        dst = stream->buffer + (usize)stream->head * stream->chunk_size;
+        mho__mutex_unlock(&stream->lock);
+
+        // The slot at head is free, so it's read into without the lock held
+        t = mho__now();
+        len = fread(dst, 1, stream->chunk_size, stream->file);
+        t = mho__now() - t;
+
+        mho__mutex_lock(&stream->lock);
+        stream->io += t;
+        if (len > 0)
+        {
+            stream->lens[stream->head] = len;
+            stream->head = (stream->head + 1) % stream->depth;
+            stream->count++;
+        }
+        if (len < stream->chunk_size)
+        {
+            stream->eof = TRUE;
+            stream->error = ferror(stream->file) != 0;
+        }
+        mho__cond_signal(&stream->filled);
+        mho__mutex_unlock(&stream->lock);
+
+        if (len < stream->chunk_size)
+            break;
+    }
+
+    MHO__THREAD_RETURN;
+}
+
+mho_stream_t *
+mho_stream_open(const char *filename,
+                usize chunk_size,
+                u32 depth)
+{
+    mho_stream_t        *stream;
+
+
+    if (chunk_size == 0)
+        chunk_size = MHO_STREAM_CHUNK_SIZE;
+    if (depth < MHO_STREAM_MIN_DEPTH)
+        depth = MHO_STREAM_MIN_DEPTH;
+
+    stream = (mho_stream_t *)calloc(1, sizeof(mho_stream_t));
+    if (!stream)
+        return NULL;
+
+    stream->chunk_size = chunk_size;
+    stream->depth = depth;
+    stream->buffer = (u8 *)malloc((usize)depth * chunk_size);
+    stream->lens = (usize *)calloc(depth, sizeof(usize));
+    stream->file = fopen(filename, "rb");
+    if (!stream->buffer || !stream->lens || !stream->file)
+    {
+        if (!stream->file)
+            fprintf(stderr, "Could not load file: %s\n", filename);
+        else
+            fclose(stream->file);
+        free(stream->lens);
+        free(stream->buffer);
+        free(stream);
+
+        return NULL;
+    }
+
+    // Reads go straight into the chunk buffers
+    setvbuf(stream->file, NULL, _IONBF, 0);
+
+    mho__mutex_init(&stream->lock);
+    mho__cond_init(&stream->filled);
+    mho__cond_init(&stream->drained);
+    stream->start = mho__now();
+
+    if (!mho__thread_create(&stream->thread, mho__stream_proc, stream))
+    {
+        mho__cond_destroy(&stream->drained);
+        mho__cond_destroy(&stream->filled);
+        mho__mutex_destroy(&stream->lock);
+        fclose(stream->file);
+        free(stream->lens);
+        free(stream->buffer);
+        free(stream);
+
+        return NULL;
+    }
+
+    return stream;
+}
+
+b32
+mho_stream_next(mho_stream_t *stream,
+                const u8 **data,
+                usize *len)
+{
+    b32                 ret = FALSE;
+    f64                 t;
+
+
+    mho__mutex_lock(&stream->lock);
+
+    // Give back the chunk handed out last time
+    if (stream->held)
+    {
+        stream->held = FALSE;
+        stream->tail = (stream->tail + 1) % stream->depth;
+        stream->count--;
+        mho__cond_signal(&stream->drained);
+    }
+
+    if (stream->count == 0 && !stream->eof)
+    {
+        t = mho__now();
+        while (stream->count == 0 && !stream->eof)
+            mho__cond_wait(&stream->filled, &stream->lock);
+        stream->stall += mho__now() - t;
+    }
+
+    if (stream->count > 0)
+    {
+        *data = stream->buffer + (usize)stream->tail * stream->chunk_size;
+        *len = stream->lens[stream->tail];
+        stream->held = TRUE;
+        stream->bytes += *len;
+        stream->chunks++;
+        ret = TRUE;
+    }
+    else
+    {
+        *data = NULL;
+        *len = 0;
+    }
+
+    mho__mutex_unlock(&stream->lock);
+
+    return ret;
+}
+
+b32
+mho_stream_error(mho_stream_t *stream)
+{
+    b32                 error;
+
+
+    mho__mutex_lock(&stream->lock);
+    error = stream->error;
+    mho__mutex_unlock(&stream->lock);
+
+    return error;
+}
+
+void
+mho_stream_stats(mho_stream_t *stream,
+                 mho_stream_stats_t *stats)
+{
+    mho__mutex_lock(&stream->lock);
+    stats->bytes = stream->bytes;
+    stats->chunks = stream->chunks;
+    stats->elapsed = mho__now() - stream->start;
+    stats->stall = stream->stall;
+    stats->io = stream->io;
+    stats->throughput = stats->elapsed > 0.0 ? (f64)stream->bytes / stats->elapsed : 0.0;
+    mho__mutex_unlock(&stream->lock);
+}
+
+void
+mho_stream_close(mho_stream_t *stream)
+{
+    if (!stream)
+        return;
+
+    mho__mutex_lock(&stream->lock);
+    stream->stop = TRUE;
+    mho__cond_broadcast(&stream->drained);
+    mho__mutex_unlock(&stream->lock);
+    mho__thread_join(stream->thread);
+
+    mho__cond_destroy(&stream->drained);
+    mho__cond_destroy(&stream->filled);
+    mho__mutex_destroy(&stream->lock);
+    fclose(stream->file);
+    free(stream->lens);
+    free(stream->buffer);
+    free(stream);
+}
+
+
+
+//-------------------- PARALLEL READS ----------------//
+
+#define MHO_READ_MAX_THREADS    32
+#define MHO_PARALLEL_READ_MIN   (64 * 1024 * 1024)  // Smaller files are read on one thread
+#define MHO_PARALLEL_READ_RANGE (8 * 1024 * 1024)   // Bytes claimed by a worker at a time
+
+// Shared state of a parallel read. Workers claim ranges through next.
+typedef struct _TAG_mho_pread_ctx
+{
+    mho__fd_t           fd;
+    u8                  *dst;
+    u64                 len,
+                        offset;
+    mho__atomic_u64     next;
+    mho__atomic_u32     failed;
+} mho_pread_ctx_t;
+
+internal
+MHO__THREAD_PROC(mho__pread_proc, arg)
+{
+    mho_pread_ctx_t     *ctx = (mho_pread_ctx_t *)arg;
+    u64                 start,
+                        len;
+
+
+    while ((start = mho__atomic_fetch_add(&ctx->next, MHO_PARALLEL_READ_RANGE)) < ctx->len)
+    {
+        len = mho_min(ctx->len - start, MHO_PARALLEL_READ_RANGE);
+        if (mho__fd_pread(ctx->fd, ctx->dst + start, len, ctx->offset + start) != (s64)len)
+            mho__atomic_store(&ctx->failed, 1);
+    }
+
+    MHO__THREAD_RETURN;
+}
+
+// Reads len bytes at offset into dst, splitting the read into ranges that
+// are read concurrently on up to thread_cnt threads. Returns FALSE on a
+// failed or short read.
+internal b32
+mho__fd_pread_parallel(mho__fd_t fd,
+                       void *dst,
+                       u64 len,
+                       u64 offset,
+                       u32 thread_cnt)
+{
+    mho_pread_ctx_t     ctx;
+
+
+    if (thread_cnt == 0)
+        thread_cnt = mho_min(2 * mho__cpu_count(), MHO_READ_MAX_THREADS);
+    thread_cnt = (u32)mho_min(thread_cnt, (len + MHO_PARALLEL_READ_RANGE - 1) / MHO_PARALLEL_READ_RANGE);
+
+    if (len < MHO_PARALLEL_READ_MIN || thread_cnt <= 1)
+        return mho__fd_pread(fd, dst, len, offset) == (s64)len;
+
+    ctx.fd = fd;
+    ctx.dst = (u8 *)dst;
+    ctx.len = len;
+    ctx.offset = offset;
+    mho__atomic_init(&ctx.next, 0);
+    mho__atomic_init(&ctx.failed, 0);
+    mho__run_threads(mho__pread_proc, &ctx, thread_cnt);
+
+    return !mho__atomic_load(&ctx.failed);
+}
+
+char *
+mho_file_read_parallel(const char *filename,
+                       u32 thread_cnt,
+                       u64 *len)
+{
+    char                *buffer = NULL;
+    mho__fd_t           fd;
+    u64                 size;
+
+
+    if (len)
+        *len = 0;
+
+    fd = mho__fd_open(filename);
+    if (fd == MHO__FD_INVALID)
+    {
+        fprintf(stderr, "Could not load file: %s\n", filename);
+        return NULL;
+    }
+
+    if (mho__fd_size(fd, &size) && size < (u64)(usize)-1)
+    {
+        buffer = (char *)malloc((usize)size + 1);
+        if (buffer)
+        {
+            if (mho__fd_pread_parallel(fd, buffer, size, 0, thread_cnt))
+            {
+                buffer[size] = 0;
+                if (len)
+                    *len = size;
+            }
+            else
+            {
+                fprintf(stderr, "Could not read full file: %s\n", filename);
+                free(buffer);
+                buffer = NULL;
+            }
+        }
+        else
+        {
+            fprintf(stderr, "Could not allocate %llu bytes for buffer for file: %s\n", (unsigned long long)size, filename);
+        }
+    }
+    else
+    {
+        fprintf(stderr, "Could not read file length: %s\n", filename);
+    }
+    mho__fd_close(fd);
+
+    return buffer;
+}
+
+// Shared state of a mho_file_read_many call. Workers claim files through
+// next, first to size them and then to read them into their spans.
+typedef struct _TAG_mho_file_batch_ctx
+{
+    const char          **filenames;
+    mho_file_span_t     *spans;
+    u32                 count;
+    b32                 sizing;
+    mho__atomic_u32     next;
+} mho_file_batch_ctx_t;
+
+// Gets the size of a file without opening it
+internal b32
+mho__file_size(const char *filename,
+               u64 *size)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    WIN32_FILE_ATTRIBUTE_DATA   attr;
+
+
+    if (!GetFileAttributesExA(filename, GetFileExInfoStandard, &attr) ||
+        (attr.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+        return FALSE;
+    *size = ((u64)attr.nFileSizeHigh << 32) | attr.nFileSizeLow;
+#else
+    struct stat                 st;
+
+
+    if (stat(filename, &st) != 0 || S_ISDIR(st.st_mode))
+        return FALSE;
+    *size = (u64)st.st_size;
+#endif
+
+    return TRUE;
+}
+
+// Reads up to size bytes of a file into dst, returning the number read or -1
+internal s64
+mho__file_read_span(const char *filename,
+                    u8 *dst,
+                    u64 size)
+{
+    mho__fd_t           fd;
+    s64                 len;
+
+
+    fd = mho__fd_open(filename);
+    if (fd == MHO__FD_INVALID)
+        return -1;
+
+    len = mho__fd_pread(fd, dst, size, 0);
+    mho__fd_close(fd);
+
+    return len;
+}
+
+internal
+MHO__THREAD_PROC(mho__file_batch_proc, arg)
+{
+    mho_file_batch_ctx_t    *ctx = (mho_file_batch_ctx_t *)arg;
+    mho_file_span_t         *span;
+    u32                     i;
+    s64                     len;
+
+
+    while ((i = mho__atomic_fetch_add(&ctx->next, 1)) < ctx->count)
+    {
+        span = &ctx->spans[i];
+        if (ctx->sizing)
+        {
+            if (!mho__file_size(ctx->filenames[i], &span->len))
+                span->error = MHO_FILE_ERR_OPEN;
+        }
+        else if (span->error == MHO_FILE_OK)
+        {
+            len = mho__file_read_span(ctx->filenames[i], (u8 *)span->data, span->len);
+            if (len < 0)
+            {
+                span->error = MHO_FILE_ERR_READ;
+                len = 0;
+            }
+            span->len = (u64)len;
+            span->data[len] = 0;
+        }
+    }
+
+    MHO__THREAD_RETURN;
+}
+
+b32
+mho_file_read_many(const char **filenames,
+                   u32 count,
+                   u32 thread_cnt,
+                   mho_file_batch_t *batch)
+{
+    mho_file_batch_ctx_t    ctx;
+    usize                   total = MHO_ALLOC_ALIGN;
+    u32                     i;
+
+
+    memset(batch, 0, sizeof(mho_file_batch_t));
+    if (count == 0)
+        return TRUE;
+
+    batch->spans = (mho_file_span_t *)calloc(count, sizeof(mho_file_span_t));
+    if (!batch->spans)
+        return FALSE;
+    batch->count = count;
+
+    // The reads are latency bound, so use more threads than cores by default
+    if (thread_cnt == 0)
+        thread_cnt = mho_min(2 * mho__cpu_count(), MHO_READ_MAX_THREADS);
+    thread_cnt = mho_min(thread_cnt, count);
+
+    ctx.filenames = filenames;
+    ctx.spans = batch->spans;
+    ctx.count = count;
+
+    // Size every file up front, so that all of them fit in one arena
+    ctx.sizing = TRUE;
+    mho__atomic_init(&ctx.next, 0);
+    mho__run_threads(mho__file_batch_proc, &ctx, thread_cnt);
+
+    for (i = 0; i < count; i++)
+    {
+        if (batch->spans[i].error == MHO_FILE_OK)
+            total += MHO_ALIGN_UP((usize)batch->spans[i].len + 1, MHO_ALLOC_ALIGN);
+    }
+
+    if (!mho_arena_init(&batch->arena, NULL, total))
+    {
+        free(batch->spans);
+        memset(batch, 0, sizeof(mho_file_batch_t));
+        return FALSE;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        if (batch->spans[i].error == MHO_FILE_OK)
+            batch->spans[i].data = (char *)mho_arena_alloc(&batch->arena, (usize)batch->spans[i].len + 1);
+    }
+
+    ctx.sizing = FALSE;
+    mho__atomic_store(&ctx.next, 0);
+    mho__run_threads(mho__file_batch_proc, &ctx, thread_cnt);
+
+    for (i = 0; i < count; i++)
+    {
+        if (batch->spans[i].error != MHO_FILE_OK)
+            batch->failed++;
+    }
+
+    return TRUE;
+}
+
+void
+mho_file_batch_free(mho_file_batch_t *batch)
+{
+    mho_arena_destroy(&batch->arena);
+    free(batch->spans);
+    memset(batch, 0, sizeof(mho_file_batch_t));
+}
+
+
+//-------------------- PARALLEL COPY ----------------//
+
+#define MHO_COPY_MAX_THREADS    32
+#ifndef MHO_PARALLEL_COPY_MIN
+    #define MHO_PARALLEL_COPY_MIN   (64 * 1024 * 1024)  // Smaller copies stay on one thread
+#endif
+#define MHO_PARALLEL_COPY_RANGE (8 * 1024 * 1024)   // Bytes claimed by a worker at a time
+
+// Shared state of a parallel copy. Ranges start at dst offsets head + k *
+// MHO_PARALLEL_COPY_RANGE so that no two workers stream to the same line.
+typedef struct _TAG_mho_pcopy_ctx
+{
+    u8                  *dst;
+    const u8            *src;
+    usize               len,
+                        head;
+    mho__atomic_u64     next;
+} mho_pcopy_ctx_t;
+
+internal
+MHO__THREAD_PROC(mho__pcopy_proc, arg)
+{
+    mho_pcopy_ctx_t     *ctx = (mho_pcopy_ctx_t *)arg;
+    usize               start,
+                        end;
+    u64                 k;
+
+
+    while (TRUE)
+    {
+        k = mho__atomic_fetch_add(&ctx->next, 1);
+        start = k ? ctx->head + (usize)(k - 1) * MHO_PARALLEL_COPY_RANGE : 0;
+        if (start >= ctx->len)
+            break;
+
+        // Range 0 is the unaligned head in front of the first full line
+        end = k ? mho_min(start + MHO_PARALLEL_COPY_RANGE, ctx->len) : ctx->head;
+        if (end - start <= 16)
+            mho__memcpy_small(ctx->dst + start, ctx->src + start, end - start);
+        else
+            mho__memcpy_bulk(ctx->dst + start, ctx->src + start, end - start, TRUE);
+    }
+
+    MHO__THREAD_RETURN;
+}
+
+void
+mho_memcpy_parallel(void *dest,
+                    void *src,
+                    usize n,
+                    u32 thread_cnt)
+{
+    mho_pcopy_ctx_t     ctx;
+
+
+    if (thread_cnt == 0)
+        thread_cnt = mho_min(mho__cpu_count(), MHO_COPY_MAX_THREADS);
+    thread_cnt = (u32)mho_min(thread_cnt, (n + MHO_PARALLEL_COPY_RANGE - 1) / MHO_PARALLEL_COPY_RANGE);
+
+    if (n < MHO_PARALLEL_COPY_MIN || thread_cnt <= 1)
+    {
+        mho_memcpy(dest, src, n);
+        return;
+    }
+
+    ctx.dst = (u8 *)dest;
+    ctx.src = (const u8 *)src;
+    ctx.len = n;
+    ctx.head = (64 - ((usize)dest & 63)) & 63;
+    mho__atomic_init(&ctx.next, 0);
+    mho__run_threads(mho__pcopy_proc, &ctx, thread_cnt);
+}
+
+//-------------------- COMPRESSION ----------------//
+
+// LZ77 codec in the LZ4 block layout. A sequence is a token (literal length
+// in the high nibble, match length - 4 in the low one, 15 meaning more
+// length bytes follow), the literals, a 16-bit little-endian offset and the
+// extra match length bytes. The last sequence is literals only, and the last
+// 5 bytes of a block are always literals so decoding never reads past them.
+
+#define MHO_LZ_MIN_MATCH        4
+#define MHO_LZ_LAST_LITERALS    5
+#define MHO_LZ_MF_LIMIT         12      // Matches can't start in the last 12 bytes
+#define MHO_LZ_MAX_OFFSET       65535
+#define MHO_LZ_HASH_BITS        13
+#define MHO_LZ_SKIP_SHIFT       6       // Speeds up the search through incompressible data
+
+#define MHO_LZ_MAGIC            0x5A4F484D  // "MHOZ"
+#define MHO_LZ_VERSION          1
+#define MHO_LZ_STORED_BIT       0x80000000  // Block is stored uncompressed
+
+// Frame header of a compressed file, followed by a u32 compressed size per
+// block (so the blocks can be located and decoded in parallel), then the
+// blocks themselves
+typedef struct _TAG_mho_lz_frame
+{
+    u32                 magic;
+    u16                 version,
+                        shuffle;        // Element size of the byte-shuffle filter, 0 = off
+    u32                 block_size,
+                        block_cnt;
+    u64                 len;            // Decompressed length
+} mho_lz_frame_t;
+
+internal u32
+mho__lz_read32(const u8 *p)
+{
+    u32                 v;
+
+
+    memcpy(&v, p, sizeof(u32));
+
+    return v;
+}
+
+internal u32
+mho__lz_hash(u32 seq)
+{
+    return (seq * 2654435761u) >> (32 - MHO_LZ_HASH_BITS);
+}
+
+// Writes a length continuation (runs of 255 then the remainder)
+internal u8 *
+mho__lz_write_len(u8 *op,
+                  usize len)
+{
+    while (len >= 255)
+    {
+        *op++ = 255;
+        len -= 255;
+    }
+    *op++ = (u8)len;
+
+    return op;
+}
+
+usize
+mho_lz_bound(usize len)
+{
+    return len + len / 255 + 16;
+}
+
+usize
+mho_lz_compress(const void *src,
+                usize len,
+                void *dst,
+                usize capacity)
+{
+    u32                 table[1 << MHO_LZ_HASH_BITS];
+    const u8            *base = (const u8 *)src,
+                        *ip = base,
+                        *anchor = base,
+                        *iend = base + len,
+                        *mflimit,
+                        *matchlimit,
+                        *ref,
+                        *mp;
+    u8                  *op = (u8 *)dst,
+                        *oend = (u8 *)dst + capacity;
+    usize               lit,
+                        mlen,
+                        offset;
+    u32                 seq,
+                        h;
+    u64                 a,
+                        b;
+
+
+    // Short inputs are a single literal run, the limits are only formed once
+    // they're known to point inside the buffer
+    if (len > MHO_LZ_MF_LIMIT)
+    {
+        mflimit = iend - MHO_LZ_MF_LIMIT;
+        matchlimit = iend - MHO_LZ_LAST_LITERALS;
+        memset(table, 0, sizeof(table));
+        ip++;
+        while (ip < mflimit)
+        {
+            seq = mho__lz_read32(ip);
+            h = mho__lz_hash(seq);
+            ref = base + table[h];
+            table[h] = (u32)(ip - base);
+            if (ip - ref > MHO_LZ_MAX_OFFSET || mho__lz_read32(ref) != seq)
+            {
+                ip += 1 + ((ip - anchor) >> MHO_LZ_SKIP_SHIFT);
+                continue;
+            }
+
+            // Extend the match backwards into the pending literals
+            while (ip > anchor && ref > base && ip[-1] == ref[-1])
+            {
+                ip--;
+                ref--;
+            }
+            offset = (usize)(ip - ref);
+
+            // Then forwards, 8 bytes at a time
+            mp = ip + MHO_LZ_MIN_MATCH;
+            ref += MHO_LZ_MIN_MATCH;
+            while (mp + 8 <= matchlimit)
+            {
+                memcpy(&a, mp, 8);
+                memcpy(&b, ref, 8);
+                if (a != b)
+                {
+                    mp += mho__ctz64(a ^ b) >> 3;
+                    goto matched;
+                }
+                mp += 8;
+                ref += 8;
+            }
+            while (mp < matchlimit && *mp == *ref)
+            {
+                mp++;
+                ref++;
+            }
+matched:
+            lit = (usize)(ip - anchor);
+            mlen = (usize)(mp - ip) - MHO_LZ_MIN_MATCH;
+            if ((usize)(oend - op) < 1 + lit / 255 + 1 + lit + 2 + mlen / 255 + 1)
+                return 0;
+
+            *op++ = (u8)((mho_min(lit, 15) << 4) | mho_min(mlen, 15));
+            if (lit >= 15)
+                op = mho__lz_write_len(op, lit - 15);
+            memcpy(op, anchor, lit);
+            op += lit;
+            *op++ = (u8)offset;
+            *op++ = (u8)(offset >> 8);
+            if (mlen >= 15)
+                op = mho__lz_write_len(op, mlen - 15);
+
+            ip = anchor = mp;
+
+            // Index a position inside the match too, it's free and helps the ratio
+            if (ip < mflimit)
+                table[mho__lz_hash(mho__lz_read32(ip - 2))] = (u32)(ip - 2 - base);
+        }
+    }
+
+    lit = (usize)(iend - anchor);
+    if ((usize)(oend - op) < 1 + lit / 255 + 1 + lit)
+        return 0;
+    *op++ = (u8)(mho_min(lit, 15) << 4);
+    if (lit >= 15)
+        op = mho__lz_write_len(op, lit - 15);
+    memcpy(op, anchor, lit);
+    op += lit;
+
+    return (usize)(op - (u8 *)dst);
+}
+
+s64
+mho_lz_decompress(const void *src,
+                  usize len,
+                  void *dst,
+                  usize capacity)
+{
+    const u8            *ip = (const u8 *)src,
+                        *iend = (const u8 *)src + len,
+                        *ref;
+    u8                  *op = (u8 *)dst,
+                        *oend = (u8 *)dst + capacity,
+                        *cpy;
+    usize               lit,
+                        mlen,
+                        offset;
+    u8                  token,
+                        b;
+
+
+    for (;;)
+    {
+        if (ip >= iend)
+            return -1;
+        token = *ip++;
+
+        lit = token >> 4;
+        if (lit == 15)
+        {
+            do
+            {
+                if (ip >= iend)
+                    return -1;
+                b = *ip++;
+                lit += b;
+            } while (b == 255);
+        }
+        if (lit > (usize)(iend - ip) || lit > (usize)(oend - op))
+            return -1;
+
+        // Short literal runs are copied with one fixed-size copy when there's room
+        if (lit <= 16 && iend - ip >= 16 && oend - op >= 16)
+            memcpy(op, ip, 16);
+        else
+            memcpy(op, ip, lit);
+        op += lit;
+        ip += lit;
+
+        if (ip == iend)
+            break;
+
+        if (iend - ip < 2)
+            return -1;
+        offset = (usize)ip[0] | ((usize)ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > (usize)(op - (u8 *)dst))
+            return -1;
+
+        mlen = token & 15;
+        if (mlen == 15)
+        {
+            do
+            {
+                if (ip >= iend)
+                    return -1;
+                b = *ip++;
+                mlen += b;
+            } while (b == 255);
+        }
+        mlen += MHO_LZ_MIN_MATCH;
+        if (mlen > (usize)(oend - op))
+            return -1;
+
+        ref = op - offset;
+        cpy = op + mlen;
+        if (offset >= 16 && (usize)(oend - op) >= mlen + 16)
+        {
+            // Non-overlapping 16-byte chunks, may write up to 15 bytes past cpy
+            do
+            {
+                memcpy(op, ref, 16);
+                op += 16;
+                ref += 16;
+            } while (op < cpy);
+        }
+        else if (offset >= 8 && (usize)(oend - op) >= mlen + 8)
+        {
+            do
+            {
+                memcpy(op, ref, 8);
+                op += 8;
+                ref += 8;
+            } while (op < cpy);
+        }
+        else
+        {
+            while (op < cpy)
+                *op++ = *ref++;
+        }
+        op = cpy;
+    }
+
+    return (s64)(op - (u8 *)dst);
+}
+
+// Groups byte b of every element together (elem_size bytes per element)
+// so the exponent/high bytes of float streams line up into long runs
+internal void
+mho__shuffle(const u8 *src,
+             u8 *dst,
+             usize len,
+             u32 elem_size)
+{
+    usize               n = len / elem_size,
+                        i;
+    u32                 b;
+
+
+    for (b = 0; b < elem_size; b++)
+    {
+        for (i = 0; i < n; i++)
+            dst[b * n + i] = src[i * elem_size + b];
+    }
+    memcpy(dst + n * elem_size, src + n * elem_size, len - n * elem_size);
+}
+
+internal void
+mho__unshuffle(const u8 *src,
+               u8 *dst,
+               usize len,
+               u32 elem_size)
+{
+    usize               n = len / elem_size,
+                        i;
+    u32                 b;
+
+
+    for (b = 0; b < elem_size; b++)
+    {
+        for (i = 0; i < n; i++)
+            dst[i * elem_size + b] = src[b * n + i];
+    }
+    memcpy(dst + n * elem_size, src + n * elem_size, len - n * elem_size);
+}
+
+// Shared state of a framed compress/decompress, workers claim blocks through next
+typedef struct _TAG_mho_lz_ctx
+{
+    const u8            *src;
+    u8                  *dst;
+    u8                  *scratch;       // One block per worker slot, for the shuffle filter
+    u32                 *sizes;
+    u64                 *offsets;       // Offset of each compressed block (decompression only)
+    u64                 len;
+    usize               bound;
+    u32                 block_size,
+                        block_cnt,
+                        shuffle;
+    mho__atomic_u32     next,
+                        slot;
+    mho__atomic_u32     failed;
+} mho_lz_ctx_t;
+
+internal
+MHO__THREAD_PROC(mho__lz_compress_proc, arg)
+{
+    mho_lz_ctx_t        *ctx = (mho_lz_ctx_t *)arg;
+    const u8            *block;
+    u8                  *out,
+                        *scratch;
+    usize               len,
+                        size;
+    u32                 i;
+
+
+    scratch = ctx->scratch + (usize)mho__atomic_fetch_add(&ctx->slot, 1) * ctx->block_size;
+    while ((i = mho__atomic_fetch_add(&ctx->next, 1)) < ctx->block_cnt)
+    {
+        block = ctx->src + (u64)i * ctx->block_size;
+        len = (usize)mho_min(ctx->len - (u64)i * ctx->block_size, ctx->block_size);
+        out = ctx->dst + (usize)i * ctx->bound;
+        if (ctx->shuffle > 1)
+        {
+            mho__shuffle(block, scratch, len, ctx->shuffle);
+            block = scratch;
+        }
+
+        // Store blocks that don't shrink as-is
+        size = mho_lz_compress(block, len, out, len - 1);
+        if (size == 0)
+        {
+            memcpy(out, block, len);
+            ctx->sizes[i] = (u32)len | MHO_LZ_STORED_BIT;
+        }
+        else
+        {
+            ctx->sizes[i] = (u32)size;
+        }
+    }
+
+    MHO__THREAD_RETURN;
+}
+
+internal
+MHO__THREAD_PROC(mho__lz_decompress_proc, arg)
+{
+    mho_lz_ctx_t        *ctx = (mho_lz_ctx_t *)arg;
+    const u8            *block;
+    u8                  *out,
+                        *scratch;
+    usize               len,
+                        size;
+    u32                 i;
+
+
+    scratch = ctx->scratch + (usize)mho__atomic_fetch_add(&ctx->slot, 1) * ctx->block_size;
+    while ((i = mho__atomic_fetch_add(&ctx->next, 1)) < ctx->block_cnt)
+    {
+        block = ctx->src + ctx->offsets[i];
+        size = ctx->sizes[i] & ~MHO_LZ_STORED_BIT;
+        len = (usize)mho_min(ctx->len - (u64)i * ctx->block_size, ctx->block_size);
+        out = ctx->dst + (u64)i * ctx->block_size;
+
+        if (ctx->sizes[i] & MHO_LZ_STORED_BIT)
+        {
+            if (size != len)
+            {
+                mho__atomic_store(&ctx->failed, 1);
+                continue;
+            }
+            memcpy(ctx->shuffle > 1 ? scratch : out, block, len);
+        }
+        else if (mho_lz_decompress(block, size, ctx->shuffle > 1 ? scratch : out, len) != (s64)len)
+        {
+            mho__atomic_store(&ctx->failed, 1);
+            continue;
+        }
+
+        if (ctx->shuffle > 1)
+            mho__unshuffle(scratch, out, len, ctx->shuffle);
+    }
+
+    MHO__THREAD_RETURN;
+}
+
+b32
+mho_file_write_compressed(const char *filename,
+                          const void *buffer,
+                          u64 byte_cnt,
+                          u32 shuffle,
+                          u32 thread_cnt)
+{
+    mho_lz_ctx_t        ctx;
+    mho_lz_frame_t      frame;
+    FILE                *fptr;
+    u32                 i;
+    b32                 ret = FALSE;
+
+
+    memset(&ctx, 0, sizeof(mho_lz_ctx_t));
+    ctx.src = (const u8 *)buffer;
+    ctx.len = byte_cnt;
+    ctx.block_size = MHO_LZ_BLOCK_SIZE;
+    ctx.block_cnt = (u32)((byte_cnt + MHO_LZ_BLOCK_SIZE - 1) / MHO_LZ_BLOCK_SIZE);
+    ctx.bound = mho_lz_bound(MHO_LZ_BLOCK_SIZE);
+    ctx.shuffle = shuffle;
+
+    if (thread_cnt == 0)
+        thread_cnt = mho__cpu_count();
+    thread_cnt = mho_max(mho_min(thread_cnt, ctx.block_cnt), 1);
+
+    ctx.dst = (u8 *)malloc((usize)ctx.block_cnt * ctx.bound);
+    ctx.sizes = (u32 *)malloc(ctx.block_cnt * sizeof(u32) + 1);
+    ctx.scratch = (u8 *)malloc((usize)thread_cnt * ctx.block_size);
+    if ((ctx.block_cnt && !ctx.dst) || !ctx.sizes || !ctx.scratch)
+        goto done;
+
+    mho__atomic_init(&ctx.next, 0);
+    mho__atomic_init(&ctx.slot, 0);
+    mho__atomic_init(&ctx.failed, 0);
+    mho__run_threads(mho__lz_compress_proc, &ctx, thread_cnt);
+
+    fptr = fopen(filename, "wb");
+    if (!fptr)
+    {
+        fprintf(stderr, "Could not load file: %s\n", filename);
+        goto done;
+    }
+
+    frame.magic = MHO_LZ_MAGIC;
+    frame.version = MHO_LZ_VERSION;
+    frame.shuffle = (u16)shuffle;
+    frame.block_size = ctx.block_size;
+    frame.block_cnt = ctx.block_cnt;
+    frame.len = byte_cnt;
+
+    ret = fwrite(&frame, sizeof(mho_lz_frame_t), 1, fptr) == 1 &&
+          fwrite(ctx.sizes, sizeof(u32), ctx.block_cnt, fptr) == ctx.block_cnt;
+    for (i = 0; ret && i < ctx.block_cnt; i++)
+    {
+        ret = fwrite(ctx.dst + (usize)i * ctx.bound, 1, ctx.sizes[i] & ~MHO_LZ_STORED_BIT, fptr) ==
+              (ctx.sizes[i] & ~MHO_LZ_STORED_BIT);
+    }
+    if (fclose(fptr) != 0)
+        ret = FALSE;
+
+    if (!ret)
+        fprintf(stderr, "Could not write compressed file: %s\n", filename);
+
+done:
+    free(ctx.scratch);
+    free(ctx.sizes);
+    free(ctx.dst);
+
+    return ret;
+}
+
+char *
+mho_file_read_compressed(const char *filename,
+                         u32 thread_cnt,
+                         u64 *len)
+{
+    mho_lz_ctx_t        ctx;
+    mho_lz_frame_t      frame;
+    mho_fmap_t          map;
+    char                *buffer = NULL;
+    u64                 offset;
+    u32                 i;
+
+
+    if (len)
+        *len = 0;
+    if (!mho_file_map(filename, MHO_FMAP_SEQUENTIAL | MHO_FMAP_WILLNEED, &map))
+        return NULL;
+
+    memset(&ctx, 0, sizeof(mho_lz_ctx_t));
+    if (map.len < sizeof(mho_lz_frame_t))
+        goto invalid;
+    memcpy(&frame, map.data, sizeof(mho_lz_frame_t));
+    if (frame.magic != MHO_LZ_MAGIC || frame.version != MHO_LZ_VERSION || frame.block_size == 0 ||
+        frame.len >= (u64)(usize)-1 ||
+        (frame.len + frame.block_size - 1) / frame.block_size != frame.block_cnt ||
+        map.len - sizeof(mho_lz_frame_t) < (u64)frame.block_cnt * sizeof(u32))
+        goto invalid;
+
+    ctx.src = map.data;
+    ctx.len = frame.len;
+    ctx.block_size = frame.block_size;
+    ctx.block_cnt = frame.block_cnt;
+    ctx.shuffle = frame.shuffle;
+    ctx.sizes = (u32 *)(map.data + sizeof(mho_lz_frame_t));
+
+    if (thread_cnt == 0)
+        thread_cnt = mho__cpu_count();
+    thread_cnt = mho_max(mho_min(thread_cnt, ctx.block_cnt), 1);
+
+    // Locate every block up front
+    ctx.offsets = (u64 *)malloc(ctx.block_cnt * sizeof(u64) + 1);
+    if (!ctx.offsets)
+        goto done;
+    offset = sizeof(mho_lz_frame_t) + (u64)ctx.block_cnt * sizeof(u32);
+    for (i = 0; i < ctx.block_cnt; i++)
+    {
+        ctx.offsets[i] = offset;
+        offset += ctx.sizes[i] & ~MHO_LZ_STORED_BIT;
+    }
+    if (offset > map.len)
+        goto invalid;
+
+    buffer = (char *)malloc((usize)frame.len + 1);
+    ctx.scratch = ctx.shuffle > 1 ? (u8 *)malloc((usize)thread_cnt * ctx.block_size) : NULL;
+    if (!buffer || (ctx.shuffle > 1 && !ctx.scratch))
+    {
+        free(buffer);
+        buffer = NULL;
+        goto done;
+    }
+    ctx.dst = (u8 *)buffer;
+
+    mho__atomic_init(&ctx.next, 0);
+    mho__atomic_init(&ctx.slot, 0);
+    mho__atomic_init(&ctx.failed, 0);
+    mho__run_threads(mho__lz_decompress_proc, &ctx, thread_cnt);
+
+    if (mho__atomic_load(&ctx.failed))
+    {
+        free(buffer);
+        buffer = NULL;
+        goto invalid;
+    }
+
+    buffer[frame.len] = 0;
+    if (len)
+        *len = frame.len;
+    goto done;
+
+invalid:
+    fprintf(stderr, "Invalid compressed file: %s\n", filename);
+done:
+    free(ctx.scratch);
+    free(ctx.offsets);
+    mho_file_unmap(&map);
+
+    return buffer;
+}
+
+
+//-------------------- PACK FILES ----------------//
+
+#define MHO_PACK_MAGIC      0x504F484D  // "MHOP"
+#define MHO_PACK_VERSION    1
+
+// Size of each element type (0 = any, for MHO_PACK_RAW)
+global const u32 mho_pack_type_sizes[] =
+{
+    0, 1, 2, 4, 8, 4, 4, 8,
+    sizeof(mho_vec2_t), sizeof(mho_vec3_t), sizeof(mho_vec4_t), sizeof(mho_mat4_t), sizeof(mho_quat_t)
+};
+
+b32
+mho_pack_write(const char *filename,
+               const mho_pack_input_t *inputs,
+               u32 count)
+{
+    mho_pack_header_t   header;
+    mho_pack_section_t  *sections;
+    FILE                *fptr;
+    u8                  zeros[MHO_PACK_ALIGN] = { 0 };
+    u64                 offset;
+    u32                 i;
+    b32                 ret = TRUE;
+
+
+    for (i = 0; i < count; i++)
+    {
+        if (inputs[i].type >= sizeof(mho_pack_type_sizes) / sizeof(*mho_pack_type_sizes) || inputs[i].elem_size == 0 ||
+            (mho_pack_type_sizes[inputs[i].type] && mho_pack_type_sizes[inputs[i].type] != inputs[i].elem_size))
+        {
+            fprintf(stderr, "Invalid pack section %u (type %u, element size %u): %s\n", i, inputs[i].type,
+                                                                                       inputs[i].elem_size,
+                                                                                       filename);
+            return FALSE;
+        }
+    }
+
+    sections = (mho_pack_section_t *)calloc(count + 1, sizeof(mho_pack_section_t));
+    if (!sections)
+        return FALSE;
+
+    offset = MHO_ALIGN_UP(sizeof(mho_pack_header_t) + (u64)count * sizeof(mho_pack_section_t), MHO_PACK_ALIGN);
+    for (i = 0; i < count; i++)
+    {
+        sections[i].id = inputs[i].id;
+        sections[i].type = inputs[i].type;
+        sections[i].elem_size = inputs[i].elem_size;
+        sections[i].count = inputs[i].count;
+        sections[i].offset = offset;
+        sections[i].checksum = mho_crc32c(0, inputs[i].data, (usize)(inputs[i].count * inputs[i].elem_size));
+        offset = MHO_ALIGN_UP(offset + inputs[i].count * inputs[i].elem_size, MHO_PACK_ALIGN);
+    }
+
+    memset(&header, 0, sizeof(mho_pack_header_t));
+    header.magic = MHO_PACK_MAGIC;
+    header.version = MHO_PACK_VERSION;
+    header.section_cnt = count;
+    header.table_checksum = mho_crc32c(0, sections, count * sizeof(mho_pack_section_t));
+    header.file_size = offset;
+
+    fptr = fopen(filename, "wb");
+    if (!fptr)
+    {
+        fprintf(stderr, "Could not load file: %s\n", filename);
+        free(sections);
+        return FALSE;
+    }
+
+    // Everything is written in order, padding each section up to the next boundary
+    offset = sizeof(mho_pack_header_t) + count * sizeof(mho_pack_section_t);
+    ret = fwrite(&header, sizeof(mho_pack_header_t), 1, fptr) == 1 &&
+          fwrite(sections, sizeof(mho_pack_section_t), count, fptr) == count;
+    for (i = 0; ret && i < count; i++)
+    {
+        ret = fwrite(zeros, 1, (usize)(sections[i].offset - offset), fptr) == sections[i].offset - offset &&
+              (inputs[i].count == 0 || fwrite(inputs[i].data, inputs[i].elem_size, (usize)inputs[i].count, fptr) == inputs[i].count);
+        offset = sections[i].offset + inputs[i].count * inputs[i].elem_size;
+    }
+    if (ret)
+        ret = fwrite(zeros, 1, (usize)(header.file_size - offset), fptr) == header.file_size - offset;
+    if (fclose(fptr) != 0)
+        ret = FALSE;
+
+    if (!ret)
+        fprintf(stderr, "Could not write pack file: %s\n", filename);
+    free(sections);
+
+    return ret;
+}
+
+b32
+mho_pack_open(const char *filename,
+              b32 verify,
+              mho_pack_t *pack)
+{
+    const mho_pack_section_t    *section;
+    u32                         i;
+
+
+    memset(pack, 0, sizeof(mho_pack_t));
+    if (!mho_file_map(filename, MHO_FMAP_RANDOM, &pack->map))
+        return FALSE;
+
+    pack->header = (const mho_pack_header_t *)pack->map.data;
+    pack->sections = (const mho_pack_section_t *)(pack->map.data + sizeof(mho_pack_header_t));
+    if (pack->map.len < sizeof(mho_pack_header_t) ||
+        pack->header->magic != MHO_PACK_MAGIC ||
+        pack->header->version != MHO_PACK_VERSION ||
+        pack->header->file_size != pack->map.len ||
+        (pack->map.len - sizeof(mho_pack_header_t)) / sizeof(mho_pack_section_t) < pack->header->section_cnt ||
+        mho_crc32c(0, pack->sections, pack->header->section_cnt * sizeof(mho_pack_section_t)) != pack->header->table_checksum)
+        goto invalid;
+
+    for (i = 0; i < pack->header->section_cnt; i++)
+    {
+        section = &pack->sections[i];
+        if (section->offset % MHO_PACK_ALIGN || section->offset > pack->map.len || section->elem_size == 0 ||
+            section->count > (pack->map.len - section->offset) / section->elem_size)
+            goto invalid;
+
+        // Same rule as the writer, a typed section must have its type's element size
+        if (section->type >= sizeof(mho_pack_type_sizes) / sizeof(*mho_pack_type_sizes) ||
+            (mho_pack_type_sizes[section->type] && mho_pack_type_sizes[section->type] != section->elem_size))
+            goto invalid;
+
+        if (verify && mho_crc32c(0, pack->map.data + section->offset,
+                                     (usize)(section->count * section->elem_size)) != section->checksum)
+            goto invalid;
+    }
+
+    return TRUE;
+
+invalid:
+    fprintf(stderr, "Invalid pack file: %s\n", filename);
+    mho_pack_close(pack);
+
+    return FALSE;
+}
+
+void
+mho_pack_close(mho_pack_t *pack)
+{
+    mho_file_unmap(&pack->map);
+    memset(pack, 0, sizeof(mho_pack_t));
+}
+
+const void *
+mho_pack_get(mho_pack_t *pack,
+             u32 id,
+             u32 type,
+             u64 *count)
+{
+    u32                 i;
+
+
+    if (count)
+        *count = 0;
+
+    for (i = 0; i < pack->header->section_cnt; i++)
+    {
+        if (pack->sections[i].id == id)
+        {
+            if (pack->sections[i].type != type)
+                return NULL;
+            if (count)
+                *count = pack->sections[i].count;
+
+            return pack->map.data + pack->sections[i].offset;
+        }
+    }
+
+    return NULL;
+}
+
+
+//-------------------- FILE CACHE ----------------//
+
+#define MHO_FCACHE_SHARDS   16
+
+// A cached file, with its data right after the struct
+typedef struct _TAG_mho_fcache_entry
+{
+    struct _TAG_mho_fcache_entry    *prev,      // LRU list (only unreferenced entries)
+                                    *next;
+    char                            *path;
+    u64                             len,
+                                    size;
+    s64                             mtime;
+    u32                             refs,
+                                    shard;
+    b32                             stale;      // Replaced by a newer version, freed on the last release
+} mho_fcache_entry_t;
+
+typedef mho_map(char *, mho_fcache_entry_t *) mho_fcache_map_t;
+
+// Each shard has its own lock, map, LRU list and slice of the budget
+typedef struct _TAG_mho_fcache_shard
+{
+    mho__mutex_t                    lock;
+    mho_fcache_map_t                map;
+    mho_fcache_entry_t              *head,      // Most recently used
+                                    *tail;
+    u64                             bytes,
+                                    entries,
+                                    hits,
+                                    misses,
+                                    evictions;
+    u8                              pad[MHO_CACHE_LINE];
+} mho_fcache_shard_t;
+
+struct _TAG_mho_fcache
+{
+    u64                             budget;     // Per shard
+    mho_fcache_shard_t              shards[MHO_FCACHE_SHARDS];
+};
+
+// Gets the size and modification time (in ns) of a file
+internal b32
+mho__fcache_stat(const char *filename,
+                 u64 *size,
+                 s64 *mtime)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    WIN32_FILE_ATTRIBUTE_DATA   attr;
+
+
+    if (!GetFileAttributesExA(filename, GetFileExInfoStandard, &attr) ||
+        (attr.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+        return FALSE;
+    *size = ((u64)attr.nFileSizeHigh << 32) | attr.nFileSizeLow;
+    *mtime = (s64)((((u64)attr.ftLastWriteTime.dwHighDateTime << 32) | attr.ftLastWriteTime.dwLowDateTime) * 100);
+#else
+    struct stat                 st;
+
+
+    if (stat(filename, &st) != 0 || S_ISDIR(st.st_mode))
+        return FALSE;
+    *size = (u64)st.st_size;
+    *mtime = (s64)st.st_mtime * 1000000000;
+#if defined(__linux__)
+    *mtime += st.st_mtim.tv_nsec;
+#elif defined(__APPLE__)
+    *mtime += st.st_mtimespec.tv_nsec;
+#endif
+#endif
+
+    return TRUE;
+}
+
+internal void
+mho__fcache_lru_unlink(mho_fcache_shard_t *shard,
+                       mho_fcache_entry_t *entry)
+{
+    if (entry->prev)
+        entry->prev->next = entry->next;
+    else
+        shard->head = entry->next;
+    if (entry->next)
+        entry->next->prev = entry->prev;
+    else
+        shard->tail = entry->prev;
+    entry->prev = entry->next = NULL;
+}
+
+internal void
+mho__fcache_lru_push(mho_fcache_shard_t *shard,
+                     mho_fcache_entry_t *entry)
+{
+    entry->prev = NULL;
+    entry->next = shard->head;
+    if (shard->head)
+        shard->head->prev = entry;
+    else
+        shard->tail = entry;
+    shard->head = entry;
+}
+
+internal void
+mho__fcache_free_entry(mho_fcache_entry_t *entry)
+{
+    free(entry->path);
+    free(entry);
+}
+
+// Drops an entry from the map, freeing it now or on its last release
+internal void
+mho__fcache_drop(mho_fcache_shard_t *shard,
+                 mho_fcache_entry_t *entry)
+{
+    mho_map_remove(shard->map, entry->path);
+    shard->bytes -= entry->len;
+    shard->entries--;
+    if (entry->refs == 0)
+    {
+        mho__fcache_lru_unlink(shard, entry);
+        mho__fcache_free_entry(entry);
+    }
+    else
+    {
+        entry->stale = TRUE;
+    }
+}
+
+// Evicts unused entries until the shard fits its budget
+internal void
+mho__fcache_trim(mho_fcache_t *cache,
+                 mho_fcache_shard_t *shard)
+{
+    while (shard->bytes > cache->budget && shard->tail)
+    {
+        mho__fcache_drop(shard, shard->tail);
+        shard->evictions++;
+    }
+}
+
+// Reads a file into a new entry
+internal mho_fcache_entry_t *
+mho__fcache_load(const char *filename,
+                 u64 size,
+                 s64 mtime)
+{
+    mho_fcache_entry_t  *entry;
+    mho__fd_t           fd;
+    s64                 len = -1;
+
+
+    if (size >= (u64)(usize)-1 - sizeof(mho_fcache_entry_t))
+        return NULL;
+
+    entry = (mho_fcache_entry_t *)malloc(sizeof(mho_fcache_entry_t) + (usize)size + 1);
+    if (!entry)
+        return NULL;
+
+    fd = mho__fd_open(filename);
+    if (fd != MHO__FD_INVALID)
+    {
+        mho__fd_advise(fd, 0, size);
+        len = mho__fd_pread(fd, entry + 1, size, 0);
+        mho__fd_close(fd);
+    }
+
+    entry->path = (char *)malloc(strlen(filename) + 1);
+    if (len < 0 || !entry->path)
+    {
+        free(entry->path);
+        free(entry);
+        return NULL;
+    }
+    memcpy(entry->path, filename, strlen(filename) + 1);
+
+    ((char *)(entry + 1))[len] = 0;
+    entry->prev = entry->next = NULL;
+    entry->len = (u64)len;
+    entry->size = size;
+    entry->mtime = mtime;
+    entry->refs = 1;
+    entry->stale = FALSE;
+
+    return entry;
+}
+
+mho_fcache_t *
+mho_fcache_create(u64 budget)
+{
+    mho_fcache_t        *cache;
+    u32                 i;
+
+
+    cache = (mho_fcache_t *)calloc(1, sizeof(mho_fcache_t));
+    if (!cache)
+        return NULL;
+
+    cache->budget = budget / MHO_FCACHE_SHARDS;
+    for (i = 0; i < MHO_FCACHE_SHARDS; i++)
+    {
+        mho__mutex_init(&cache->shards[i].lock);
+        mho_map_set_fns(cache->shards[i].map, mho_map_hash_str, mho_map_eq_str);
+    }
+
+    return cache;
+}
+
+void
+mho_fcache_destroy(mho_fcache_t *cache)
+{
+    mho_fcache_shard_t  *shard;
+    u64                 slot;
+    u32                 i;
+
+
+    if (!cache)
+        return;
+
+    for (i = 0; i < MHO_FCACHE_SHARDS; i++)
+    {
+        shard = &cache->shards[i];
+        for (slot = 0; slot < mho_map_capacity(shard->map); slot++)
+        {
+            if (mho_map_slot_used(shard->map, slot))
+                mho__fcache_free_entry(shard->map->vals[slot]);
+        }
+        mho_map_free(shard->map);
+        mho__mutex_destroy(&shard->lock);
+    }
+    free(cache);
+}
+
+const char *
+mho_fcache_get(mho_fcache_t *cache,
+               const char *filename,
+               u64 *len)
+{
+    mho_fcache_shard_t  *shard;
+    mho_fcache_entry_t  **found,
+                        *entry;
+    u64                 size;
+    s64                 mtime;
+    u32                 shard_idx;
+
+
+    if (len)
+        *len = 0;
+    if (!mho__fcache_stat(filename, &size, &mtime))
+        return NULL;
+
+    shard_idx = (u32)(mho_map_hash_str(&filename, sizeof(char *)) % MHO_FCACHE_SHARDS);
+    shard = &cache->shards[shard_idx];
+
+    mho__mutex_lock(&shard->lock);
+    found = mho_map_get_ptr(shard->map, (char *)filename);
+    if (found && (*found)->size == size && (*found)->mtime == mtime)
+    {
+        entry = *found;
+        if (entry->refs++ == 0)
+            mho__fcache_lru_unlink(shard, entry);
+        shard->hits++;
+        mho__mutex_unlock(&shard->lock);
+        goto hit;
+    }
+    if (found)
+        mho__fcache_drop(shard, *found);
+    shard->misses++;
+    mho__mutex_unlock(&shard->lock);
+
+    // Read without holding the lock, then check nobody beat us to it
+    entry = mho__fcache_load(filename, size, mtime);
+    if (!entry)
+        return NULL;
+    entry->shard = shard_idx;
+
+    mho__mutex_lock(&shard->lock);
+    found = mho_map_get_ptr(shard->map, (char *)filename);
+    if (found && (*found)->size == size && (*found)->mtime == mtime)
+    {
+        mho__fcache_free_entry(entry);
+        entry = *found;
+        if (entry->refs++ == 0)
+            mho__fcache_lru_unlink(shard, entry);
+    }
+    else
+    {
+        if (found)
+            mho__fcache_drop(shard, *found);
+        if (mho_map_put(shard->map, entry->path, entry))
+        {
+            shard->bytes += entry->len;
+            shard->entries++;
+            mho__fcache_trim(cache, shard);
+        }
+        else
+        {
+            // Out of memory for the map, hand the data out uncached
+            entry->stale = TRUE;
+        }
+    }
+    mho__mutex_unlock(&shard->lock);
+
+hit:
+    if (len)
+        *len = entry->len;
+
+    return (const char *)(entry + 1);
+}
+
+void
+mho_fcache_release(mho_fcache_t *cache,
+                   const char *data)
+{
+    mho_fcache_entry_t  *entry;
+    mho_fcache_shard_t  *shard;
+
+
+    if (!data)
+        return;
+
+    entry = (mho_fcache_entry_t *)data - 1;
+    shard = &cache->shards[entry->shard];
+
+    mho__mutex_lock(&shard->lock);
+    if (--entry->refs == 0)
+    {
+        if (entry->stale)
+        {
+            mho__fcache_free_entry(entry);
+        }
+        else
+        {
+            mho__fcache_lru_push(shard, entry);
+            mho__fcache_trim(cache, shard);
+        }
+    }
+    mho__mutex_unlock(&shard->lock);
+}
+
+void
+mho_fcache_stats(mho_fcache_t *cache,
+                 mho_fcache_stats_t *stats)
+{
+    mho_fcache_shard_t  *shard;
+    u32                 i;
+
+
+    memset(stats, 0, sizeof(mho_fcache_stats_t));
+    for (i = 0; i < MHO_FCACHE_SHARDS; i++)
+    {
+        shard = &cache->shards[i];
+        mho__mutex_lock(&shard->lock);
+        stats->hits += shard->hits;
+        stats->misses += shard->misses;
+        stats->evictions += shard->evictions;
+        stats->bytes += shard->bytes;
+        stats->entries += shard->entries;
+        mho__mutex_unlock(&shard->lock);
+    }
+}
+
+
+//-------------------- NUMBER PARSING ----------------//
+
+// Decimal float parsing in the style of strtod, over a buffer that needn't be
+// NULL-terminated. Numbers whose digits fit in a machine word and whose
+// power of ten is small enough for exact float arithmetic (Clinger's fast
+// path) are converted with a single correctly-rounded multiply or divide.
+// The rest of the finite range goes through the Eisel-Lemire algorithm, and
+// only inf/nan/hex and numbers with over 19 digits that land too close to a
+// rounding boundary fall back to strtod/strtof.
+
+#define MHO_PARSE_MAX_DIGITS    19
+#define MHO_PARSE_MAX_TOKEN     64
+
+global const f64 mho_pow10_f64[] =
+{
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+global const f32 mho_pow10_f32[] =
+{
+    1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+};
+
+#define MHO_POW5_MIN_EXP    -342
+#define MHO_POW5_MAX_EXP    308
+
+// 5^q for q in [-342, 308] as 128-bit (hi, lo) mantissas normalized to the
+// top bit, truncated for q >= 0 and rounded up for q < 0
+global const u64 mho_pow5_128[] =
+{
+    0xEEF453D6923BD65AULL, 0x113FAA2906A13B3FULL,
+    0x9558B4661B6565F8ULL, 0x4AC7CA59A424C507ULL,
+    0xBAAEE17FA23EBF76ULL, 0x5D79BCF00D2DF649ULL,
+    0xE95A99DF8ACE6F53ULL, 0xF4D82C2C107973DCULL,
+    0x91D8A02BB6C10594ULL, 0x79071B9B8A4BE869ULL,
+    0xB64EC836A47146F9ULL, 0x9748E2826CDEE284ULL,
+    0xE3E27A444D8D98B7ULL, 0xFD1B1B2308169B25ULL,
+    0x8E6D8C6AB0787F72ULL, 0xFE30F0F5E50E20F7ULL,
+    0xB208EF855C969F4FULL, 0xBDBD2D335E51A935ULL,
+    0xDE8B2B66B3BC4723ULL, 0xAD2C788035E61382ULL,
+    0x8B16FB203055AC76ULL, 0x4C3BCB5021AFCC31ULL,
+    0xADDCB9E83C6B1793ULL, 0xDF4ABE242A1BBF3DULL,
+    0xD953E8624B85DD78ULL, 0xD71D6DAD34A2AF0DULL,
+    0x87D4713D6F33AA6BULL, 0x8672648C40E5AD68ULL,
+    0xA9C98D8CCB009506ULL, 0x680EFDAF511F18C2ULL,
+    0xD43BF0EFFDC0BA48ULL, 0x0212BD1B2566DEF2ULL,
+    0x84A57695FE98746DULL, 0x014BB630F7604B57ULL,
+    0xA5CED43B7E3E9188ULL, 0x419EA3BD35385E2DULL,
+    0xCF42894A5DCE35EAULL, 0x52064CAC828675B9ULL,
+    0x818995CE7AA0E1B2ULL, 0x7343EFEBD1940993ULL,
+    0xA1EBFB4219491A1FULL, 0x1014EBE6C5F90BF8ULL,
+    0xCA66FA129F9B60A6ULL, 0xD41A26E077774EF6ULL,
+    0xFD00B897478238D0ULL, 0x8920B098955522B4ULL,
+    0x9E20735E8CB16382ULL, 0x55B46E5F5D5535B0ULL,
+    0xC5A890362FDDBC62ULL, 0xEB2189F734AA831DULL,
+    0xF712B443BBD52B7BULL, 0xA5E9EC7501D523E4ULL,
+    0x9A6BB0AA55653B2DULL, 0x47B233C92125366EULL,
+    0xC1069CD4EABE89F8ULL, 0x999EC0BB696E840AULL,
+    0xF148440A256E2C76ULL, 0xC00670EA43CA250DULL,
+    0x96CD2A865764DBCAULL, 0x380406926A5E5728ULL,
+    0xBC807527ED3E12BCULL, 0xC605083704F5ECF2ULL,
+    0xEBA09271E88D976BULL, 0xF7864A44C633682EULL,
+    0x93445B8731587EA3ULL, 0x7AB3EE6AFBE0211DULL,
+    0xB8157268FDAE9E4CULL, 0x5960EA05BAD82964ULL,
+    0xE61ACF033D1A45DFULL, 0x6FB92487298E33BDULL,
+    0x8FD0C16206306BABULL, 0xA5D3B6D479F8E056ULL,
+    0xB3C4F1BA87BC8696ULL, 0x8F48A4899877186CULL,
+    0xE0B62E2929ABA83CULL, 0x331ACDABFE94DE87ULL,
+    0x8C71DCD9BA0B4925ULL, 0x9FF0C08B7F1D0B14ULL,
+    0xAF8E5410288E1B6FULL, 0x07ECF0AE5EE44DD9ULL,
+    0xDB71E91432B1A24AULL, 0xC9E82CD9F69D6150ULL,
+    0x892731AC9FAF056EULL, 0xBE311C083A225CD2ULL,
+    0xAB70FE17C79AC6CAULL, 0x6DBD630A48AAF406ULL,
+    0xD64D3D9DB981787DULL, 0x092CBBCCDAD5B108ULL,
+    0x85F0468293F0EB4EULL, 0x25BBF56008C58EA5ULL,
+    0xA76C582338ED2621ULL, 0xAF2AF2B80AF6F24EULL,
+    0xD1476E2C07286FAAULL, 0x1AF5AF660DB4AEE1ULL,
+    0x82CCA4DB847945CAULL, 0x50D98D9FC890ED4DULL,
+    0xA37FCE126597973CULL, 0xE50FF107BAB528A0ULL,
+    0xCC5FC196FEFD7D0CULL, 0x1E53ED49A96272C8ULL,
+    0xFF77B1FCBEBCDC4FULL, 0x25E8E89C13BB0F7AULL,
+    0x9FAACF3DF73609B1ULL, 0x77B191618C54E9ACULL,
+    0xC795830D75038C1DULL, 0xD59DF5B9EF6A2417ULL,
+    0xF97AE3D0D2446F25ULL, 0x4B0573286B44AD1DULL,
+    0x9BECCE62836AC577ULL, 0x4EE367F9430AEC32ULL,
+    0xC2E801FB244576D5ULL, 0x229C41F793CDA73FULL,
+    0xF3A20279ED56D48AULL, 0x6B43527578C1110FULL,
+    0x9845418C345644D6ULL, 0x830A13896B78AAA9ULL,
+    0xBE5691EF416BD60CULL, 0x23CC986BC656D553ULL,
+    0xEDEC366B11C6CB8FULL, 0x2CBFBE86B7EC8AA8ULL,
+    0x94B3A202EB1C3F39ULL, 0x7BF7D71432F3D6A9ULL,
+    0xB9E08A83A5E34F07ULL, 0xDAF5CCD93FB0CC53ULL,
+    0xE858AD248F5C22C9ULL, 0xD1B3400F8F9CFF68ULL,
+    0x91376C36D99995BEULL, 0x23100809B9C21FA1ULL,
+    0xB58547448FFFFB2DULL, 0xABD40A0C2832A78AULL,
+    0xE2E69915B3FFF9F9ULL, 0x16C90C8F323F516CULL,
+    0x8DD01FAD907FFC3BULL, 0xAE3DA7D97F6792E3ULL,
+    0xB1442798F49FFB4AULL, 0x99CD11CFDF41779CULL,
+    0xDD95317F31C7FA1DULL, 0x40405643D711D583ULL,
+    0x8A7D3EEF7F1CFC52ULL, 0x482835EA666B2572ULL,
+    0xAD1C8EAB5EE43B66ULL, 0xDA3243650005EECFULL,
+    0xD863B256369D4A40ULL, 0x90BED43E40076A82ULL,
+    0x873E4F75E2224E68ULL, 0x5A7744A6E804A291ULL,
+    0xA90DE3535AAAE202ULL, 0x711515D0A205CB36ULL,
+    0xD3515C2831559A83ULL, 0x0D5A5B44CA873E03ULL,
+    0x8412D9991ED58091ULL, 0xE858790AFE9486C2ULL,
+    0xA5178FFF668AE0B6ULL, 0x626E974DBE39A872ULL,
+    0xCE5D73FF402D98E3ULL, 0xFB0A3D212DC8128FULL,
+    0x80FA687F881C7F8EULL, 0x7CE66634BC9D0B99ULL,
+    0xA139029F6A239F72ULL, 0x1C1FFFC1EBC44E80ULL,
+    0xC987434744AC874EULL, 0xA327FFB266B56220ULL,
+    0xFBE9141915D7A922ULL, 0x4BF1FF9F0062BAA8ULL,
+    0x9D71AC8FADA6C9B5ULL, 0x6F773FC3603DB4A9ULL,
+    0xC4CE17B399107C22ULL, 0xCB550FB4384D21D3ULL,
+    0xF6019DA07F549B2BULL, 0x7E2A53A146606A48ULL,
+    0x99C102844F94E0FBULL, 0x2EDA7444CBFC426DULL,
+    0xC0314325637A1939ULL, 0xFA911155FEFB5308ULL,
+    0xF03D93EEBC589F88ULL, 0x793555AB7EBA27CAULL,
+    0x96267C7535B763B5ULL, 0x4BC1558B2F3458DEULL,
+    0xBBB01B9283253CA2ULL, 0x9EB1AAEDFB016F16ULL,
+    0xEA9C227723EE8BCBULL, 0x465E15A979C1CADCULL,
+    0x92A1958A7675175FULL, 0x0BFACD89EC191EC9ULL,
+    0xB749FAED14125D36ULL, 0xCEF980EC671F667BULL,
+    0xE51C79A85916F484ULL, 0x82B7E12780E7401AULL,
+    0x8F31CC0937AE58D2ULL, 0xD1B2ECB8B0908810ULL,
+    0xB2FE3F0B8599EF07ULL, 0x861FA7E6DCB4AA15ULL,
+    0xDFBDCECE67006AC9ULL, 0x67A791E093E1D49AULL,
+    0x8BD6A141006042BDULL, 0xE0C8BB2C5C6D24E0ULL,
+    0xAECC49914078536DULL, 0x58FAE9F773886E18ULL,
+    0xDA7F5BF590966848ULL, 0xAF39A475506A899EULL,
+    0x888F99797A5E012DULL, 0x6D8406C952429603ULL,
+    0xAAB37FD7D8F58178ULL, 0xC8E5087BA6D33B83ULL,
+    0xD5605FCDCF32E1D6ULL, 0xFB1E4A9A90880A64ULL,
+    0x855C3BE0A17FCD26ULL, 0x5CF2EEA09A55067FULL,
+    0xA6B34AD8C9DFC06FULL, 0xF42FAA48C0EA481EULL,
+    0xD0601D8EFC57B08BULL, 0xF13B94DAF124DA26ULL,
+    0x823C12795DB6CE57ULL, 0x76C53D08D6B70858ULL,
+    0xA2CB1717B52481EDULL, 0x54768C4B0C64CA6EULL,
+    0xCB7DDCDDA26DA268ULL, 0xA9942F5DCF7DFD09ULL,
+    0xFE5D54150B090B02ULL, 0xD3F93B35435D7C4CULL,
+    0x9EFA548D26E5A6E1ULL, 0xC47BC5014A1A6DAFULL,
+    0xC6B8E9B0709F109AULL, 0x359AB6419CA1091BULL,
+    0xF867241C8CC6D4C0ULL, 0xC30163D203C94B62ULL,
+    0x9B407691D7FC44F8ULL, 0x79E0DE63425DCF1DULL,
+    0xC21094364DFB5636ULL, 0x985915FC12F542E4ULL,
+    0xF294B943E17A2BC4ULL, 0x3E6F5B7B17B2939DULL,
+    0x979CF3CA6CEC5B5AULL, 0xA705992CEECF9C42ULL,
+    0xBD8430BD08277231ULL, 0x50C6FF782A838353ULL,
+    0xECE53CEC4A314EBDULL, 0xA4F8BF5635246428ULL,
+    0x940F4613AE5ED136ULL, 0x871B7795E136BE99ULL,
+    0xB913179899F68584ULL, 0x28E2557B59846E3FULL,
+    0xE757DD7EC07426E5ULL, 0x331AEADA2FE589CFULL,
+    0x9096EA6F3848984FULL, 0x3FF0D2C85DEF7621ULL,
+    0xB4BCA50B065ABE63ULL, 0x0FED077A756B53A9ULL,
+    0xE1EBCE4DC7F16DFBULL, 0xD3E8495912C62894ULL,
+    0x8D3360F09CF6E4BDULL, 0x64712DD7ABBBD95CULL,
+    0xB080392CC4349DECULL, 0xBD8D794D96AACFB3ULL,
+    0xDCA04777F541C567ULL, 0xECF0D7A0FC5583A0ULL,
+    0x89E42CAAF9491B60ULL, 0xF41686C49DB57244ULL,
+    0xAC5D37D5B79B6239ULL, 0x311C2875C522CED5ULL,
+    0xD77485CB25823AC7ULL, 0x7D633293366B828BULL,
+    0x86A8D39EF77164BCULL, 0xAE5DFF9C02033197ULL,
+    0xA8530886B54DBDEBULL, 0xD9F57F830283FDFCULL,
+    0xD267CAA862A12D66ULL, 0xD072DF63C324FD7BULL,
+    0x8380DEA93DA4BC60ULL, 0x4247CB9E59F71E6DULL,
+    0xA46116538D0DEB78ULL, 0x52D9BE85F074E608ULL,
+    0xCD795BE870516656ULL, 0x67902E276C921F8BULL,
+    0x806BD9714632DFF6ULL, 0x00BA1CD8A3DB53B6ULL,
+    0xA086CFCD97BF97F3ULL, 0x80E8A40ECCD228A4ULL,
+    0xC8A883C0FDAF7DF0ULL, 0x6122CD128006B2CDULL,
+    0xFAD2A4B13D1B5D6CULL, 0x796B805720085F81ULL,
+    0x9CC3A6EEC6311A63ULL, 0xCBE3303674053BB0ULL,
+    0xC3F490AA77BD60FCULL, 0xBEDBFC4411068A9CULL,
+    0xF4F1B4D515ACB93BULL, 0xEE92FB5515482D44ULL,
+    0x991711052D8BF3C5ULL, 0x751BDD152D4D1C4AULL,
+    0xBF5CD54678EEF0B6ULL, 0xD262D45A78A0635DULL,
+    0xEF340A98172AACE4ULL, 0x86FB897116C87C34ULL,
+    0x9580869F0E7AAC0EULL, 0xD45D35E6AE3D4DA0ULL,
+    0xBAE0A846D2195712ULL, 0x8974836059CCA109ULL,
+    0xE998D258869FACD7ULL, 0x2BD1A438703FC94BULL,
+    0x91FF83775423CC06ULL, 0x7B6306A34627DDCFULL,
+    0xB67F6455292CBF08ULL, 0x1A3BC84C17B1D542ULL,
+    0xE41F3D6A7377EECAULL, 0x20CABA5F1D9E4A93ULL,
+    0x8E938662882AF53EULL, 0x547EB47B7282EE9CULL,
+    0xB23867FB2A35B28DULL, 0xE99E619A4F23AA43ULL,
+    0xDEC681F9F4C31F31ULL, 0x6405FA00E2EC94D4ULL,
+    0x8B3C113C38F9F37EULL, 0xDE83BC408DD3DD04ULL,
+    0xAE0B158B4738705EULL, 0x9624AB50B148D445ULL,
+    0xD98DDAEE19068C76ULL, 0x3BADD624DD9B0957ULL,
+    0x87F8A8D4CFA417C9ULL, 0xE54CA5D70A80E5D6ULL,
+    0xA9F6D30A038D1DBCULL, 0x5E9FCF4CCD211F4CULL,
+    0xD47487CC8470652BULL, 0x7647C3200069671FULL,
+    0x84C8D4DFD2C63F3BULL, 0x29ECD9F40041E073ULL,
+    0xA5FB0A17C777CF09ULL, 0xF468107100525890ULL,
+    0xCF79CC9DB955C2CCULL, 0x7182148D4066EEB4ULL,
+    0x81AC1FE293D599BFULL, 0xC6F14CD848405530ULL,
+    0xA21727DB38CB002FULL, 0xB8ADA00E5A506A7CULL,
+    0xCA9CF1D206FDC03BULL, 0xA6D90811F0E4851CULL,
+    0xFD442E4688BD304AULL, 0x908F4A166D1DA663ULL,
+    0x9E4A9CEC15763E2EULL, 0x9A598E4E043287FEULL,
+    0xC5DD44271AD3CDBAULL, 0x40EFF1E1853F29FDULL,
+    0xF7549530E188C128ULL, 0xD12BEE59E68EF47CULL,
+    0x9A94DD3E8CF578B9ULL, 0x82BB74F8301958CEULL,
+    0xC13A148E3032D6E7ULL, 0xE36A52363C1FAF01ULL,
+    0xF18899B1BC3F8CA1ULL, 0xDC44E6C3CB279AC1ULL,
+    0x96F5600F15A7B7E5ULL, 0x29AB103A5EF8C0B9ULL,
+    0xBCB2B812DB11A5DEULL, 0x7415D448F6B6F0E7ULL,
+    0xEBDF661791D60F56ULL, 0x111B495B3464AD21ULL,
+    0x936B9FCEBB25C995ULL, 0xCAB10DD900BEEC34ULL,
+    0xB84687C269EF3BFBULL, 0x3D5D514F40EEA742ULL,
+    0xE65829B3046B0AFAULL, 0x0CB4A5A3112A5112ULL,
+    0x8FF71A0FE2C2E6DCULL, 0x47F0E785EABA72ABULL,
+    0xB3F4E093DB73A093ULL, 0x59ED216765690F56ULL,
+    0xE0F218B8D25088B8ULL, 0x306869C13EC3532CULL,
+    0x8C974F7383725573ULL, 0x1E414218C73A13FBULL,
+    0xAFBD2350644EEACFULL, 0xE5D1929EF90898FAULL,
+    0xDBAC6C247D62A583ULL, 0xDF45F746B74ABF39ULL,
+    0x894BC396CE5DA772ULL, 0x6B8BBA8C328EB783ULL,
+    0xAB9EB47C81F5114FULL, 0x066EA92F3F326564ULL,
+    0xD686619BA27255A2ULL, 0xC80A537B0EFEFEBDULL,
+    0x8613FD0145877585ULL, 0xBD06742CE95F5F36ULL,
+    0xA798FC4196E952E7ULL, 0x2C48113823B73704ULL,
+    0xD17F3B51FCA3A7A0ULL, 0xF75A15862CA504C5ULL,
+    0x82EF85133DE648C4ULL, 0x9A984D73DBE722FBULL,
+    0xA3AB66580D5FDAF5ULL, 0xC13E60D0D2E0EBBAULL,
+    0xCC963FEE10B7D1B3ULL, 0x318DF905079926A8ULL,
+    0xFFBBCFE994E5C61FULL, 0xFDF17746497F7052ULL,
+    0x9FD561F1FD0F9BD3ULL, 0xFEB6EA8BEDEFA633ULL,
+    0xC7CABA6E7C5382C8ULL, 0xFE64A52EE96B8FC0ULL,
+    0xF9BD690A1B68637BULL, 0x3DFDCE7AA3C673B0ULL,
+    0x9C1661A651213E2DULL, 0x06BEA10CA65C084EULL,
+    0xC31BFA0FE5698DB8ULL, 0x486E494FCFF30A62ULL,
+    0xF3E2F893DEC3F126ULL, 0x5A89DBA3C3EFCCFAULL,
+    0x986DDB5C6B3A76B7ULL, 0xF89629465A75E01CULL,
+    0xBE89523386091465ULL, 0xF6BBB397F1135823ULL,
+    0xEE2BA6C0678B597FULL, 0x746AA07DED582E2CULL,
+    0x94DB483840B717EFULL, 0xA8C2A44EB4571CDCULL,
+    0xBA121A4650E4DDEBULL, 0x92F34D62616CE413ULL,
+    0xE896A0D7E51E1566ULL, 0x77B020BAF9C81D17ULL,
+    0x915E2486EF32CD60ULL, 0x0ACE1474DC1D122EULL,
+    0xB5B5ADA8AAFF80B8ULL, 0x0D819992132456BAULL,
+    0xE3231912D5BF60E6ULL, 0x10E1FFF697ED6C69ULL,
+    0x8DF5EFABC5979C8FULL, 0xCA8D3FFA1EF463C1ULL,
+    0xB1736B96B6FD83B3ULL, 0xBD308FF8A6B17CB2ULL,
+    0xDDD0467C64BCE4A0ULL, 0xAC7CB3F6D05DDBDEULL,
+    0x8AA22C0DBEF60EE4ULL, 0x6BCDF07A423AA96BULL,
+    0xAD4AB7112EB3929DULL, 0x86C16C98D2C953C6ULL,
+    0xD89D64D57A607744ULL, 0xE871C7BF077BA8B7ULL,
+    0x87625F056C7C4A8BULL, 0x11471CD764AD4972ULL,
+    0xA93AF6C6C79B5D2DULL, 0xD598E40D3DD89BCFULL,
+    0xD389B47879823479ULL, 0x4AFF1D108D4EC2C3ULL,
+    0x843610CB4BF160CBULL, 0xCEDF722A585139BAULL,
+    0xA54394FE1EEDB8FEULL, 0xC2974EB4EE658828ULL,
+    0xCE947A3DA6A9273EULL, 0x733D226229FEEA32ULL,
+    0x811CCC668829B887ULL, 0x0806357D5A3F525FULL,
+    0xA163FF802A3426A8ULL, 0xCA07C2DCB0CF26F7ULL,
+    0xC9BCFF6034C13052ULL, 0xFC89B393DD02F0B5ULL,
+    0xFC2C3F3841F17C67ULL, 0xBBAC2078D443ACE2ULL,
+    0x9D9BA7832936EDC0ULL, 0xD54B944B84AA4C0DULL,
+    0xC5029163F384A931ULL, 0x0A9E795E65D4DF11ULL,
+    0xF64335BCF065D37DULL, 0x4D4617B5FF4A16D5ULL,
+    0x99EA0196163FA42EULL, 0x504BCED1BF8E4E45ULL,
+    0xC06481FB9BCF8D39ULL, 0xE45EC2862F71E1D6ULL,
+    0xF07DA27A82C37088ULL, 0x5D767327BB4E5A4CULL,
+    0x964E858C91BA2655ULL, 0x3A6A07F8D510F86FULL,
+    0xBBE226EFB628AFEAULL, 0x890489F70A55368BULL,
+    0xEADAB0ABA3B2DBE5ULL, 0x2B45AC74CCEA842EULL,
+    0x92C8AE6B464FC96FULL, 0x3B0B8BC90012929DULL,
+    0xB77ADA0617E3BBCBULL, 0x09CE6EBB40173744ULL,
+    0xE55990879DDCAABDULL, 0xCC420A6A101D0515ULL,
+    0x8F57FA54C2A9EAB6ULL, 0x9FA946824A12232DULL,
+    0xB32DF8E9F3546564ULL, 0x47939822DC96ABF9ULL,
+    0xDFF9772470297EBDULL, 0x59787E2B93BC56F7ULL,
+    0x8BFBEA76C619EF36ULL, 0x57EB4EDB3C55B65AULL,
+    0xAEFAE51477A06B03ULL, 0xEDE622920B6B23F1ULL,
+    0xDAB99E59958885C4ULL, 0xE95FAB368E45ECEDULL,
+    0x88B402F7FD75539BULL, 0x11DBCB0218EBB414ULL,
+    0xAAE103B5FCD2A881ULL, 0xD652BDC29F26A119ULL,
+    0xD59944A37C0752A2ULL, 0x4BE76D3346F0495FULL,
+    0x857FCAE62D8493A5ULL, 0x6F70A4400C562DDBULL,
+    0xA6DFBD9FB8E5B88EULL, 0xCB4CCD500F6BB952ULL,
+    0xD097AD07A71F26B2ULL, 0x7E2000A41346A7A7ULL,
+    0x825ECC24C873782FULL, 0x8ED400668C0C28C8ULL,
+    0xA2F67F2DFA90563BULL, 0x728900802F0F32FAULL,
+    0xCBB41EF979346BCAULL, 0x4F2B40A03AD2FFB9ULL,
+    0xFEA126B7D78186BCULL, 0xE2F610C84987BFA8ULL,
+    0x9F24B832E6B0F436ULL, 0x0DD9CA7D2DF4D7C9ULL,
+    0xC6EDE63FA05D3143ULL, 0x91503D1C79720DBBULL,
+    0xF8A95FCF88747D94ULL, 0x75A44C6397CE912AULL,
+    0x9B69DBE1B548CE7CULL, 0xC986AFBE3EE11ABAULL,
+    0xC24452DA229B021BULL, 0xFBE85BADCE996168ULL,
+    0xF2D56790AB41C2A2ULL, 0xFAE27299423FB9C3ULL,
+    0x97C560BA6B0919A5ULL, 0xDCCD879FC967D41AULL,
+    0xBDB6B8E905CB600FULL, 0x5400E987BBC1C920ULL,
+    0xED246723473E3813ULL, 0x290123E9AAB23B68ULL,
+    0x9436C0760C86E30BULL, 0xF9A0B6720AAF6521ULL,
+    0xB94470938FA89BCEULL, 0xF808E40E8D5B3E69ULL,
+    0xE7958CB87392C2C2ULL, 0xB60B1D1230B20E04ULL,
+    0x90BD77F3483BB9B9ULL, 0xB1C6F22B5E6F48C2ULL,
+    0xB4ECD5F01A4AA828ULL, 0x1E38AEB6360B1AF3ULL,
+    0xE2280B6C20DD5232ULL, 0x25C6DA63C38DE1B0ULL,
+    0x8D590723948A535FULL, 0x579C487E5A38AD0EULL,
+    0xB0AF48EC79ACE837ULL, 0x2D835A9DF0C6D851ULL,
+    0xDCDB1B2798182244ULL, 0xF8E431456CF88E65ULL,
+    0x8A08F0F8BF0F156BULL, 0x1B8E9ECB641B58FFULL,
+    0xAC8B2D36EED2DAC5ULL, 0xE272467E3D222F3FULL,
+    0xD7ADF884AA879177ULL, 0x5B0ED81DCC6ABB0FULL,
+    0x86CCBB52EA94BAEAULL, 0x98E947129FC2B4E9ULL,
+    0xA87FEA27A539E9A5ULL, 0x3F2398D747B36224ULL,
+    0xD29FE4B18E88640EULL, 0x8EEC7F0D19A03AADULL,
+    0x83A3EEEEF9153E89ULL, 0x1953CF68300424ACULL,
+    0xA48CEAAAB75A8E2BULL, 0x5FA8C3423C052DD7ULL,
+    0xCDB02555653131B6ULL, 0x3792F412CB06794DULL,
+    0x808E17555F3EBF11ULL, 0xE2BBD88BBEE40BD0ULL,
+    0xA0B19D2AB70E6ED6ULL, 0x5B6ACEAEAE9D0EC4ULL,
+    0xC8DE047564D20A8BULL, 0xF245825A5A445275ULL,
+    0xFB158592BE068D2EULL, 0xEED6E2F0F0D56712ULL,
+    0x9CED737BB6C4183DULL, 0x55464DD69685606BULL,
+    0xC428D05AA4751E4CULL, 0xAA97E14C3C26B886ULL,
+    0xF53304714D9265DFULL, 0xD53DD99F4B3066A8ULL,
+    0x993FE2C6D07B7FABULL, 0xE546A8038EFE4029ULL,
+    0xBF8FDB78849A5F96ULL, 0xDE98520472BDD033ULL,
+    0xEF73D256A5C0F77CULL, 0x963E66858F6D4440ULL,
+    0x95A8637627989AADULL, 0xDDE7001379A44AA8ULL,
+    0xBB127C53B17EC159ULL, 0x5560C018580D5D52ULL,
+    0xE9D71B689DDE71AFULL, 0xAAB8F01E6E10B4A6ULL,
+    0x9226712162AB070DULL, 0xCAB3961304CA70E8ULL,
+    0xB6B00D69BB55C8D1ULL, 0x3D607B97C5FD0D22ULL,
+    0xE45C10C42A2B3B05ULL, 0x8CB89A7DB77C506AULL,
+    0x8EB98A7A9A5B04E3ULL, 0x77F3608E92ADB242ULL,
+    0xB267ED1940F1C61CULL, 0x55F038B237591ED3ULL,
+    0xDF01E85F912E37A3ULL, 0x6B6C46DEC52F6688ULL,
+    0x8B61313BBABCE2C6ULL, 0x2323AC4B3B3DA015ULL,
+    0xAE397D8AA96C1B77ULL, 0xABEC975E0A0D081AULL,
+    0xD9C7DCED53C72255ULL, 0x96E7BD358C904A21ULL,
+    0x881CEA14545C7575ULL, 0x7E50D64177DA2E54ULL,
+    0xAA242499697392D2ULL, 0xDDE50BD1D5D0B9E9ULL,
+    0xD4AD2DBFC3D07787ULL, 0x955E4EC64B44E864ULL,
+    0x84EC3C97DA624AB4ULL, 0xBD5AF13BEF0B113EULL,
+    0xA6274BBDD0FADD61ULL, 0xECB1AD8AEACDD58EULL,
+    0xCFB11EAD453994BAULL, 0x67DE18EDA5814AF2ULL,
+    0x81CEB32C4B43FCF4ULL, 0x80EACF948770CED7ULL,
+    0xA2425FF75E14FC31ULL, 0xA1258379A94D028DULL,
+    0xCAD2F7F5359A3B3EULL, 0x096EE45813A04330ULL,
+    0xFD87B5F28300CA0DULL, 0x8BCA9D6E188853FCULL,
+    0x9E74D1B791E07E48ULL, 0x775EA264CF55347EULL,
+    0xC612062576589DDAULL, 0x95364AFE032A819EULL,
+    0xF79687AED3EEC551ULL, 0x3A83DDBD83F52205ULL,
+    0x9ABE14CD44753B52ULL, 0xC4926A9672793543ULL,
+    0xC16D9A0095928A27ULL, 0x75B7053C0F178294ULL,
+    0xF1C90080BAF72CB1ULL, 0x5324C68B12DD6339ULL,
+    0x971DA05074DA7BEEULL, 0xD3F6FC16EBCA5E04ULL,
+    0xBCE5086492111AEAULL, 0x88F4BB1CA6BCF585ULL,
+    0xEC1E4A7DB69561A5ULL, 0x2B31E9E3D06C32E6ULL,
+    0x9392EE8E921D5D07ULL, 0x3AFF322E62439FD0ULL,
+    0xB877AA3236A4B449ULL, 0x09BEFEB9FAD487C3ULL,
+    0xE69594BEC44DE15BULL, 0x4C2EBE687989A9B4ULL,
+    0x901D7CF73AB0ACD9ULL, 0x0F9D37014BF60A11ULL,
+    0xB424DC35095CD80FULL, 0x538484C19EF38C95ULL,
+    0xE12E13424BB40E13ULL, 0x2865A5F206B06FBAULL,
+    0x8CBCCC096F5088CBULL, 0xF93F87B7442E45D4ULL,
+    0xAFEBFF0BCB24AAFEULL, 0xF78F69A51539D749ULL,
+    0xDBE6FECEBDEDD5BEULL, 0xB573440E5A884D1CULL,
+    0x89705F4136B4A597ULL, 0x31680A88F8953031ULL,
+    0xABCC77118461CEFCULL, 0xFDC20D2B36BA7C3EULL,
+    0xD6BF94D5E57A42BCULL, 0x3D32907604691B4DULL,
+    0x8637BD05AF6C69B5ULL, 0xA63F9A49C2C1B110ULL,
+    0xA7C5AC471B478423ULL, 0x0FCF80DC33721D54ULL,
+    0xD1B71758E219652BULL, 0xD3C36113404EA4A9ULL,
+    0x83126E978D4FDF3BULL, 0x645A1CAC083126EAULL,
+    0xA3D70A3D70A3D70AULL, 0x3D70A3D70A3D70A4ULL,
+    0xCCCCCCCCCCCCCCCCULL, 0xCCCCCCCCCCCCCCCDULL,
+    0x8000000000000000ULL, 0x0000000000000000ULL,
+    0xA000000000000000ULL, 0x0000000000000000ULL,
+    0xC800000000000000ULL, 0x0000000000000000ULL,
+    0xFA00000000000000ULL, 0x0000000000000000ULL,
+    0x9C40000000000000ULL, 0x0000000000000000ULL,
+    0xC350000000000000ULL, 0x0000000000000000ULL,
+    0xF424000000000000ULL, 0x0000000000000000ULL,
+    0x9896800000000000ULL, 0x0000000000000000ULL,
+    0xBEBC200000000000ULL, 0x0000000000000000ULL,
+    0xEE6B280000000000ULL, 0x0000000000000000ULL,
+    0x9502F90000000000ULL, 0x0000000000000000ULL,
+    0xBA43B74000000000ULL, 0x0000000000000000ULL,
+    0xE8D4A51000000000ULL, 0x0000000000000000ULL,
+    0x9184E72A00000000ULL, 0x0000000000000000ULL,
+    0xB5E620F480000000ULL, 0x0000000000000000ULL,
+    0xE35FA931A0000000ULL, 0x0000000000000000ULL,
+    0x8E1BC9BF04000000ULL, 0x0000000000000000ULL,
+    0xB1A2BC2EC5000000ULL, 0x0000000000000000ULL,
+    0xDE0B6B3A76400000ULL, 0x0000000000000000ULL,
+    0x8AC7230489E80000ULL, 0x0000000000000000ULL,
+    0xAD78EBC5AC620000ULL, 0x0000000000000000ULL,
+    0xD8D726B7177A8000ULL, 0x0000000000000000ULL,
+    0x878678326EAC9000ULL, 0x0000000000000000ULL,
+    0xA968163F0A57B400ULL, 0x0000000000000000ULL,
+    0xD3C21BCECCEDA100ULL, 0x0000000000000000ULL,
+    0x84595161401484A0ULL, 0x0000000000000000ULL,
+    0xA56FA5B99019A5C8ULL, 0x0000000000000000ULL,
+    0xCECB8F27F4200F3AULL, 0x0000000000000000ULL,
+    0x813F3978F8940984ULL, 0x4000000000000000ULL,
+    0xA18F07D736B90BE5ULL, 0x5000000000000000ULL,
+    0xC9F2C9CD04674EDEULL, 0xA400000000000000ULL,
+    0xFC6F7C4045812296ULL, 0x4D00000000000000ULL,
+    0x9DC5ADA82B70B59DULL, 0xF020000000000000ULL,
+    0xC5371912364CE305ULL, 0x6C28000000000000ULL,
+    0xF684DF56C3E01BC6ULL, 0xC732000000000000ULL,
+    0x9A130B963A6C115CULL, 0x3C7F400000000000ULL,
+    0xC097CE7BC90715B3ULL, 0x4B9F100000000000ULL,
+    0xF0BDC21ABB48DB20ULL, 0x1E86D40000000000ULL,
+    0x96769950B50D88F4ULL, 0x1314448000000000ULL,
+    0xBC143FA4E250EB31ULL, 0x17D955A000000000ULL,
+    0xEB194F8E1AE525FDULL, 0x5DCFAB0800000000ULL,
+    0x92EFD1B8D0CF37BEULL, 0x5AA1CAE500000000ULL,
+    0xB7ABC627050305ADULL, 0xF14A3D9E40000000ULL,
+    0xE596B7B0C643C719ULL, 0x6D9CCD05D0000000ULL,
+    0x8F7E32CE7BEA5C6FULL, 0xE4820023A2000000ULL,
+    0xB35DBF821AE4F38BULL, 0xDDA2802C8A800000ULL,
+    0xE0352F62A19E306EULL, 0xD50B2037AD200000ULL,
+    0x8C213D9DA502DE45ULL, 0x4526F422CC340000ULL,
+    0xAF298D050E4395D6ULL, 0x9670B12B7F410000ULL,
+    0xDAF3F04651D47B4CULL, 0x3C0CDD765F114000ULL,
+    0x88D8762BF324CD0FULL, 0xA5880A69FB6AC800ULL,
+    0xAB0E93B6EFEE0053ULL, 0x8EEA0D047A457A00ULL,
+    0xD5D238A4ABE98068ULL, 0x72A4904598D6D880ULL,
+    0x85A36366EB71F041ULL, 0x47A6DA2B7F864750ULL,
+    0xA70C3C40A64E6C51ULL, 0x999090B65F67D924ULL,
+    0xD0CF4B50CFE20765ULL, 0xFFF4B4E3F741CF6DULL,
+    0x82818F1281ED449FULL, 0xBFF8F10E7A8921A4ULL,
+    0xA321F2D7226895C7ULL, 0xAFF72D52192B6A0DULL,
+    0xCBEA6F8CEB02BB39ULL, 0x9BF4F8A69F764490ULL,
+    0xFEE50B7025C36A08ULL, 0x02F236D04753D5B4ULL,
+    0x9F4F2726179A2245ULL, 0x01D762422C946590ULL,
+    0xC722F0EF9D80AAD6ULL, 0x424D3AD2B7B97EF5ULL,
+    0xF8EBAD2B84E0D58BULL, 0xD2E0898765A7DEB2ULL,
+    0x9B934C3B330C8577ULL, 0x63CC55F49F88EB2FULL,
+    0xC2781F49FFCFA6D5ULL, 0x3CBF6B71C76B25FBULL,
+    0xF316271C7FC3908AULL, 0x8BEF464E3945EF7AULL,
+    0x97EDD871CFDA3A56ULL, 0x97758BF0E3CBB5ACULL,
+    0xBDE94E8E43D0C8ECULL, 0x3D52EEED1CBEA317ULL,
+    0xED63A231D4C4FB27ULL, 0x4CA7AAA863EE4BDDULL,
+    0x945E455F24FB1CF8ULL, 0x8FE8CAA93E74EF6AULL,
+    0xB975D6B6EE39E436ULL, 0xB3E2FD538E122B44ULL,
+    0xE7D34C64A9C85D44ULL, 0x60DBBCA87196B616ULL,
+    0x90E40FBEEA1D3A4AULL, 0xBC8955E946FE31CDULL,
+    0xB51D13AEA4A488DDULL, 0x6BABAB6398BDBE41ULL,
+    0xE264589A4DCDAB14ULL, 0xC696963C7EED2DD1ULL,
+    0x8D7EB76070A08AECULL, 0xFC1E1DE5CF543CA2ULL,
+    0xB0DE65388CC8ADA8ULL, 0x3B25A55F43294BCBULL,
+    0xDD15FE86AFFAD912ULL, 0x49EF0EB713F39EBEULL,
+    0x8A2DBF142DFCC7ABULL, 0x6E3569326C784337ULL,
+    0xACB92ED9397BF996ULL, 0x49C2C37F07965404ULL,
+    0xD7E77A8F87DAF7FBULL, 0xDC33745EC97BE906ULL,
+    0x86F0AC99B4E8DAFDULL, 0x69A028BB3DED71A3ULL,
+    0xA8ACD7C0222311BCULL, 0xC40832EA0D68CE0CULL,
+    0xD2D80DB02AABD62BULL, 0xF50A3FA490C30190ULL,
+    0x83C7088E1AAB65DBULL, 0x792667C6DA79E0FAULL,
+    0xA4B8CAB1A1563F52ULL, 0x577001B891185938ULL,
+    0xCDE6FD5E09ABCF26ULL, 0xED4C0226B55E6F86ULL,
+    0x80B05E5AC60B6178ULL, 0x544F8158315B05B4ULL,
+    0xA0DC75F1778E39D6ULL, 0x696361AE3DB1C721ULL,
+    0xC913936DD571C84CULL, 0x03BC3A19CD1E38E9ULL,
+    0xFB5878494ACE3A5FULL, 0x04AB48A04065C723ULL,
+    0x9D174B2DCEC0E47BULL, 0x62EB0D64283F9C76ULL,
+    0xC45D1DF942711D9AULL, 0x3BA5D0BD324F8394ULL,
+    0xF5746577930D6500ULL, 0xCA8F44EC7EE36479ULL,
+    0x9968BF6ABBE85F20ULL, 0x7E998B13CF4E1ECBULL,
+    0xBFC2EF456AE276E8ULL, 0x9E3FEDD8C321A67EULL,
+    0xEFB3AB16C59B14A2ULL, 0xC5CFE94EF3EA101EULL,
+    0x95D04AEE3B80ECE5ULL, 0xBBA1F1D158724A12ULL,
+    0xBB445DA9CA61281FULL, 0x2A8A6E45AE8EDC97ULL,
+    0xEA1575143CF97226ULL, 0xF52D09D71A3293BDULL,
+    0x924D692CA61BE758ULL, 0x593C2626705F9C56ULL,
+    0xB6E0C377CFA2E12EULL, 0x6F8B2FB00C77836CULL,
+    0xE498F455C38B997AULL, 0x0B6DFB9C0F956447ULL,
+    0x8EDF98B59A373FECULL, 0x4724BD4189BD5EACULL,
+    0xB2977EE300C50FE7ULL, 0x58EDEC91EC2CB657ULL,
+    0xDF3D5E9BC0F653E1ULL, 0x2F2967B66737E3EDULL,
+    0x8B865B215899F46CULL, 0xBD79E0D20082EE74ULL,
+    0xAE67F1E9AEC07187ULL, 0xECD8590680A3AA11ULL,
+    0xDA01EE641A708DE9ULL, 0xE80E6F4820CC9495ULL,
+    0x884134FE908658B2ULL, 0x3109058D147FDCDDULL,
+    0xAA51823E34A7EEDEULL, 0xBD4B46F0599FD415ULL,
+    0xD4E5E2CDC1D1EA96ULL, 0x6C9E18AC7007C91AULL,
+    0x850FADC09923329EULL, 0x03E2CF6BC604DDB0ULL,
+    0xA6539930BF6BFF45ULL, 0x84DB8346B786151CULL,
+    0xCFE87F7CEF46FF16ULL, 0xE612641865679A63ULL,
+    0x81F14FAE158C5F6EULL, 0x4FCB7E8F3F60C07EULL,
+    0xA26DA3999AEF7749ULL, 0xE3BE5E330F38F09DULL,
+    0xCB090C8001AB551CULL, 0x5CADF5BFD3072CC5ULL,
+    0xFDCB4FA002162A63ULL, 0x73D9732FC7C8F7F6ULL,
+    0x9E9F11C4014DDA7EULL, 0x2867E7FDDCDD9AFAULL,
+    0xC646D63501A1511DULL, 0xB281E1FD541501B8ULL,
+    0xF7D88BC24209A565ULL, 0x1F225A7CA91A4226ULL,
+    0x9AE757596946075FULL, 0x3375788DE9B06958ULL,
+    0xC1A12D2FC3978937ULL, 0x0052D6B1641C83AEULL,
+    0xF209787BB47D6B84ULL, 0xC0678C5DBD23A49AULL,
+    0x9745EB4D50CE6332ULL, 0xF840B7BA963646E0ULL,
+    0xBD176620A501FBFFULL, 0xB650E5A93BC3D898ULL,
+    0xEC5D3FA8CE427AFFULL, 0xA3E51F138AB4CEBEULL,
+    0x93BA47C980E98CDFULL, 0xC66F336C36B10137ULL,
+    0xB8A8D9BBE123F017ULL, 0xB80B0047445D4184ULL,
+    0xE6D3102AD96CEC1DULL, 0xA60DC059157491E5ULL,
+    0x9043EA1AC7E41392ULL, 0x87C89837AD68DB2FULL,
+    0xB454E4A179DD1877ULL, 0x29BABE4598C311FBULL,
+    0xE16A1DC9D8545E94ULL, 0xF4296DD6FEF3D67AULL,
+    0x8CE2529E2734BB1DULL, 0x1899E4A65F58660CULL,
+    0xB01AE745B101E9E4ULL, 0x5EC05DCFF72E7F8FULL,
+    0xDC21A1171D42645DULL, 0x76707543F4FA1F73ULL,
+    0x899504AE72497EBAULL, 0x6A06494A791C53A8ULL,
+    0xABFA45DA0EDBDE69ULL, 0x0487DB9D17636892ULL,
+    0xD6F8D7509292D603ULL, 0x45A9D2845D3C42B6ULL,
+    0x865B86925B9BC5C2ULL, 0x0B8A2392BA45A9B2ULL,
+    0xA7F26836F282B732ULL, 0x8E6CAC7768D7141EULL,
+    0xD1EF0244AF2364FFULL, 0x3207D795430CD926ULL,
+    0x8335616AED761F1FULL, 0x7F44E6BD49E807B8ULL,
+    0xA402B9C5A8D3A6E7ULL, 0x5F16206C9C6209A6ULL,
+    0xCD036837130890A1ULL, 0x36DBA887C37A8C0FULL,
+    0x802221226BE55A64ULL, 0xC2494954DA2C9789ULL,
+    0xA02AA96B06DEB0FDULL, 0xF2DB9BAA10B7BD6CULL,
+    0xC83553C5C8965D3DULL, 0x6F92829494E5ACC7ULL,
+    0xFA42A8B73ABBF48CULL, 0xCB772339BA1F17F9ULL,
+    0x9C69A97284B578D7ULL, 0xFF2A760414536EFBULL,
+    0xC38413CF25E2D70DULL, 0xFEF5138519684ABAULL,
+    0xF46518C2EF5B8CD1ULL, 0x7EB258665FC25D69ULL,
+    0x98BF2F79D5993802ULL, 0xEF2F773FFBD97A61ULL,
+    0xBEEEFB584AFF8603ULL, 0xAAFB550FFACFD8FAULL,
+    0xEEAABA2E5DBF6784ULL, 0x95BA2A53F983CF38ULL,
+    0x952AB45CFA97A0B2ULL, 0xDD945A747BF26183ULL,
+    0xBA756174393D88DFULL, 0x94F971119AEEF9E4ULL,
+    0xE912B9D1478CEB17ULL, 0x7A37CD5601AAB85DULL,
+    0x91ABB422CCB812EEULL, 0xAC62E055C10AB33AULL,
+    0xB616A12B7FE617AAULL, 0x577B986B314D6009ULL,
+    0xE39C49765FDF9D94ULL, 0xED5A7E85FDA0B80BULL,
+    0x8E41ADE9FBEBC27DULL, 0x14588F13BE847307ULL,
+    0xB1D219647AE6B31CULL, 0x596EB2D8AE258FC8ULL,
+    0xDE469FBD99A05FE3ULL, 0x6FCA5F8ED9AEF3BBULL,
+    0x8AEC23D680043BEEULL, 0x25DE7BB9480D5854ULL,
+    0xADA72CCC20054AE9ULL, 0xAF561AA79A10AE6AULL,
+    0xD910F7FF28069DA4ULL, 0x1B2BA1518094DA04ULL,
+    0x87AA9AFF79042286ULL, 0x90FB44D2F05D0842ULL,
+    0xA99541BF57452B28ULL, 0x353A1607AC744A53ULL,
+    0xD3FA922F2D1675F2ULL, 0x42889B8997915CE8ULL,
+    0x847C9B5D7C2E09B7ULL, 0x69956135FEBADA11ULL,
+    0xA59BC234DB398C25ULL, 0x43FAB9837E699095ULL,
+    0xCF02B2C21207EF2EULL, 0x94F967E45E03F4BBULL,
+    0x8161AFB94B44F57DULL, 0x1D1BE0EEBAC278F5ULL,
+    0xA1BA1BA79E1632DCULL, 0x6462D92A69731732ULL,
+    0xCA28A291859BBF93ULL, 0x7D7B8F7503CFDCFEULL,
+    0xFCB2CB35E702AF78ULL, 0x5CDA735244C3D43EULL,
+    0x9DEFBF01B061ADABULL, 0x3A0888136AFA64A7ULL,
+    0xC56BAEC21C7A1916ULL, 0x088AAA1845B8FDD0ULL,
+    0xF6C69A72A3989F5BULL, 0x8AAD549E57273D45ULL,
+    0x9A3C2087A63F6399ULL, 0x36AC54E2F678864BULL,
+    0xC0CB28A98FCF3C7FULL, 0x84576A1BB416A7DDULL,
+    0xF0FDF2D3F3C30B9FULL, 0x656D44A2A11C51D5ULL,
+    0x969EB7C47859E743ULL, 0x9F644AE5A4B1B325ULL,
+    0xBC4665B596706114ULL, 0x873D5D9F0DDE1FEEULL,
+    0xEB57FF22FC0C7959ULL, 0xA90CB506D155A7EAULL,
+    0x9316FF75DD87CBD8ULL, 0x09A7F12442D588F2ULL,
+    0xB7DCBF5354E9BECEULL, 0x0C11ED6D538AEB2FULL,
+    0xE5D3EF282A242E81ULL, 0x8F1668C8A86DA5FAULL,
+    0x8FA475791A569D10ULL, 0xF96E017D694487BCULL,
+    0xB38D92D760EC4455ULL, 0x37C981DCC395A9ACULL,
+    0xE070F78D3927556AULL, 0x85BBE253F47B1417ULL,
+    0x8C469AB843B89562ULL, 0x93956D7478CCEC8EULL,
+    0xAF58416654A6BABBULL, 0x387AC8D1970027B2ULL,
+    0xDB2E51BFE9D0696AULL, 0x06997B05FCC0319EULL,
+    0x88FCF317F22241E2ULL, 0x441FECE3BDF81F03ULL,
+    0xAB3C2FDDEEAAD25AULL, 0xD527E81CAD7626C3ULL,
+    0xD60B3BD56A5586F1ULL, 0x8A71E223D8D3B074ULL,
+    0x85C7056562757456ULL, 0xF6872D5667844E49ULL,
+    0xA738C6BEBB12D16CULL, 0xB428F8AC016561DBULL,
+    0xD106F86E69D785C7ULL, 0xE13336D701BEBA52ULL,
+    0x82A45B450226B39CULL, 0xECC0024661173473ULL,
+    0xA34D721642B06084ULL, 0x27F002D7F95D0190ULL,
+    0xCC20CE9BD35C78A5ULL, 0x31EC038DF7B441F4ULL,
+    0xFF290242C83396CEULL, 0x7E67047175A15271ULL,
+    0x9F79A169BD203E41ULL, 0x0F0062C6E984D386ULL,
+    0xC75809C42C684DD1ULL, 0x52C07B78A3E60868ULL,
+    0xF92E0C3537826145ULL, 0xA7709A56CCDF8A82ULL,
+    0x9BBCC7A142B17CCBULL, 0x88A66076400BB691ULL,
+    0xC2ABF989935DDBFEULL, 0x6ACFF893D00EA435ULL,
+    0xF356F7EBF83552FEULL, 0x0583F6B8C4124D43ULL,
+    0x98165AF37B2153DEULL, 0xC3727A337A8B704AULL,
+    0xBE1BF1B059E9A8D6ULL, 0x744F18C0592E4C5CULL,
+    0xEDA2EE1C7064130CULL, 0x1162DEF06F79DF73ULL,
+    0x9485D4D1C63E8BE7ULL, 0x8ADDCB5645AC2BA8ULL,
+    0xB9A74A0637CE2EE1ULL, 0x6D953E2BD7173692ULL,
+    0xE8111C87C5C1BA99ULL, 0xC8FA8DB6CCDD0437ULL,
+    0x910AB1D4DB9914A0ULL, 0x1D9C9892400A22A2ULL,
+    0xB54D5E4A127F59C8ULL, 0x2503BEB6D00CAB4BULL,
+    0xE2A0B5DC971F303AULL, 0x2E44AE64840FD61DULL,
+    0x8DA471A9DE737E24ULL, 0x5CEAECFED289E5D2ULL,
+    0xB10D8E1456105DADULL, 0x7425A83E872C5F47ULL,
+    0xDD50F1996B947518ULL, 0xD12F124E28F77719ULL,
+    0x8A5296FFE33CC92FULL, 0x82BD6B70D99AAA6FULL,
+    0xACE73CBFDC0BFB7BULL, 0x636CC64D1001550BULL,
+    0xD8210BEFD30EFA5AULL, 0x3C47F7E05401AA4EULL,
+    0x8714A775E3E95C78ULL, 0x65ACFAEC34810A71ULL,
+    0xA8D9D1535CE3B396ULL, 0x7F1839A741A14D0DULL,
+    0xD31045A8341CA07CULL, 0x1EDE48111209A050ULL,
+    0x83EA2B892091E44DULL, 0x934AED0AAB460432ULL,
+    0xA4E4B66B68B65D60ULL, 0xF81DA84D5617853FULL,
+    0xCE1DE40642E3F4B9ULL, 0x36251260AB9D668EULL,
+    0x80D2AE83E9CE78F3ULL, 0xC1D72B7C6B426019ULL,
+    0xA1075A24E4421730ULL, 0xB24CF65B8612F81FULL,
+    0xC94930AE1D529CFCULL, 0xDEE033F26797B627ULL,
+    0xFB9B7CD9A4A7443CULL, 0x169840EF017DA3B1ULL,
+    0x9D412E0806E88AA5ULL, 0x8E1F289560EE864EULL,
+    0xC491798A08A2AD4EULL, 0xF1A6F2BAB92A27E2ULL,
+    0xF5B5D7EC8ACB58A2ULL, 0xAE10AF696774B1DBULL,
+    0x9991A6F3D6BF1765ULL, 0xACCA6DA1E0A8EF29ULL,
+    0xBFF610B0CC6EDD3FULL, 0x17FD090A58D32AF3ULL,
+    0xEFF394DCFF8A948EULL, 0xDDFC4B4CEF07F5B0ULL,
+    0x95F83D0A1FB69CD9ULL, 0x4ABDAF101564F98EULL,
+    0xBB764C4CA7A4440FULL, 0x9D6D1AD41ABE37F1ULL,
+    0xEA53DF5FD18D5513ULL, 0x84C86189216DC5EDULL,
+    0x92746B9BE2F8552CULL, 0x32FD3CF5B4E49BB4ULL,
+    0xB7118682DBB66A77ULL, 0x3FBC8C33221DC2A1ULL,
+    0xE4D5E82392A40515ULL, 0x0FABAF3FEAA5334AULL,
+    0x8F05B1163BA6832DULL, 0x29CB4D87F2A7400EULL,
+    0xB2C71D5BCA9023F8ULL, 0x743E20E9EF511012ULL,
+    0xDF78E4B2BD342CF6ULL, 0x914DA9246B255416ULL,
+    0x8BAB8EEFB6409C1AULL, 0x1AD089B6C2F7548EULL,
+    0xAE9672ABA3D0C320ULL, 0xA184AC2473B529B1ULL,
+    0xDA3C0F568CC4F3E8ULL, 0xC9E5D72D90A2741EULL,
+    0x8865899617FB1871ULL, 0x7E2FA67C7A658892ULL,
+    0xAA7EEBFB9DF9DE8DULL, 0xDDBB901B98FEEAB7ULL,
+    0xD51EA6FA85785631ULL, 0x552A74227F3EA565ULL,
+    0x8533285C936B35DEULL, 0xD53A88958F87275FULL,
+    0xA67FF273B8460356ULL, 0x8A892ABAF368F137ULL,
+    0xD01FEF10A657842CULL, 0x2D2B7569B0432D85ULL,
+    0x8213F56A67F6B29BULL, 0x9C3B29620E29FC73ULL,
+    0xA298F2C501F45F42ULL, 0x8349F3BA91B47B8FULL,
+    0xCB3F2F7642717713ULL, 0x241C70A936219A73ULL,
+    0xFE0EFB53D30DD4D7ULL, 0xED238CD383AA0110ULL,
+    0x9EC95D1463E8A506ULL, 0xF4363804324A40AAULL,
+    0xC67BB4597CE2CE48ULL, 0xB143C6053EDCD0D5ULL,
+    0xF81AA16FDC1B81DAULL, 0xDD94B7868E94050AULL,
+    0x9B10A4E5E9913128ULL, 0xCA7CF2B4191C8326ULL,
+    0xC1D4CE1F63F57D72ULL, 0xFD1C2F611F63A3F0ULL,
+    0xF24A01A73CF2DCCFULL, 0xBC633B39673C8CECULL,
+    0x976E41088617CA01ULL, 0xD5BE0503E085D813ULL,
+    0xBD49D14AA79DBC82ULL, 0x4B2D8644D8A74E18ULL,
+    0xEC9C459D51852BA2ULL, 0xDDF8E7D60ED1219EULL,
+    0x93E1AB8252F33B45ULL, 0xCABB90E5C942B503ULL,
+    0xB8DA1662E7B00A17ULL, 0x3D6A751F3B936243ULL,
+    0xE7109BFBA19C0C9DULL, 0x0CC512670A783AD4ULL,
+    0x906A617D450187E2ULL, 0x27FB2B80668B24C5ULL,
+    0xB484F9DC9641E9DAULL, 0xB1F9F660802DEDF6ULL,
+    0xE1A63853BBD26451ULL, 0x5E7873F8A0396973ULL,
+    0x8D07E33455637EB2ULL, 0xDB0B487B6423E1E8ULL,
+    0xB049DC016ABC5E5FULL, 0x91CE1A9A3D2CDA62ULL,
+    0xDC5C5301C56B75F7ULL, 0x7641A140CC7810FBULL,
+    0x89B9B3E11B6329BAULL, 0xA9E904C87FCB0A9DULL,
+    0xAC2820D9623BF429ULL, 0x546345FA9FBDCD44ULL,
+    0xD732290FBACAF133ULL, 0xA97C177947AD4095ULL,
+    0x867F59A9D4BED6C0ULL, 0x49ED8EABCCCC485DULL,
+    0xA81F301449EE8C70ULL, 0x5C68F256BFFF5A74ULL,
+    0xD226FC195C6A2F8CULL, 0x73832EEC6FFF3111ULL,
+    0x83585D8FD9C25DB7ULL, 0xC831FD53C5FF7EABULL,
+    0xA42E74F3D032F525ULL, 0xBA3E7CA8B77F5E55ULL,
+    0xCD3A1230C43FB26FULL, 0x28CE1BD2E55F35EBULL,
+    0x80444B5E7AA7CF85ULL, 0x7980D163CF5B81B3ULL,
+    0xA0555E361951C366ULL, 0xD7E105BCC332621FULL,
+    0xC86AB5C39FA63440ULL, 0x8DD9472BF3FEFAA7ULL,
+    0xFA856334878FC150ULL, 0xB14F98F6F0FEB951ULL,
+    0x9C935E00D4B9D8D2ULL, 0x6ED1BF9A569F33D3ULL,
+    0xC3B8358109E84F07ULL, 0x0A862F80EC4700C8ULL,
+    0xF4A642E14C6262C8ULL, 0xCD27BB612758C0FAULL,
+    0x98E7E9CCCFBD7DBDULL, 0x8038D51CB897789CULL,
+    0xBF21E44003ACDD2CULL, 0xE0470A63E6BD56C3ULL,
+    0xEEEA5D5004981478ULL, 0x1858CCFCE06CAC74ULL,
+    0x95527A5202DF0CCBULL, 0x0F37801E0C43EBC8ULL,
+    0xBAA718E68396CFFDULL, 0xD30560258F54E6BAULL,
+    0xE950DF20247C83FDULL, 0x47C6B82EF32A2069ULL,
+    0x91D28B7416CDD27EULL, 0x4CDC331D57FA5441ULL,
+    0xB6472E511C81471DULL, 0xE0133FE4ADF8E952ULL,
+    0xE3D8F9E563A198E5ULL, 0x58180FDDD97723A6ULL,
+    0x8E679C2F5E44FF8FULL, 0x570F09EAA7EA7648ULL,
+};
+
+#define mho__is_digit(__c)  ((u32)((__c) - '0') < 10)
+#define mho__is_space(__c)  ((__c) == ' ' || (__c) == '\t' || (__c) == '\r' || (__c) == '\v' || (__c) == '\f')
+
+// Splits the decimal number at p into its sign, its first 19 significant
+// digits and a power of ten. Returns the end of the number, or NULL if p
+// doesn't start with one (inf/nan and hex included, those are left to the
+// fallback).
+internal const char *
+mho__scan_decimal(const char *p,
+                  const char *end,
+                  b32 *neg,
+                  u64 *mant,
+                  s32 *exp10,
+                  b32 *truncated)
+{
+    const char          *exp_start;
+    u32                 digits = 0;
+    s32                 e = 0,
+                        exp_val = 0;
+    b32                 any = FALSE,
+                        exp_neg = FALSE;
+
+
+    *neg = FALSE;
+    *mant = 0;
+    *truncated = FALSE;
+
+    if (p < end && (*p == '-' || *p == '+'))
+        *neg = (*p++ == '-');
+
+    // Otherwise the leading 0 of a hex float would scan as a whole number
+    if (end - p >= 2 && p[0] == '0' && (p[1] == 'x' || p[1] == 'X'))
+        return NULL;
+
+    for (; p < end && mho__is_digit(*p); p++)
+    {
+        any = TRUE;
+        if (digits < MHO_PARSE_MAX_DIGITS)
+        {
+            *mant = *mant * 10 + (u64)(*p - '0');
+            digits += (*mant != 0);
+        }
+        else
+        {
+            e++;
+            *truncated |= (*p != '0');
+        }
+    }
+
+    if (p < end && *p == '.')
+    {
+        for (p++; p < end && mho__is_digit(*p); p++)
+        {
+            any = TRUE;
+            if (digits < MHO_PARSE_MAX_DIGITS)
+            {
+                *mant = *mant * 10 + (u64)(*p - '0');
+                digits += (*mant != 0);
+                e--;
+            }
+            else
+            {
+                *truncated |= (*p != '0');
+            }
+        }
+    }
+
+    if (!any)
+        return NULL;
+
+    // An exponent without digits isn't part of the number
+    if (p < end && (*p == 'e' || *p == 'E'))
+    {
+        exp_start = p++;
+        if (p < end && (*p == '-' || *p == '+'))
+            exp_neg = (*p++ == '-');
+        if (p < end && mho__is_digit(*p))
+        {
+            for (; p < end && mho__is_digit(*p); p++)
+            {
+                if (exp_val < 100000)
+                    exp_val = exp_val * 10 + (*p - '0');
+            }
+            e += exp_neg ? -exp_val : exp_val;
+        }
+        else
+        {
+            p = exp_start;
+        }
+    }
+
+    *exp10 = e;
+
+    return p;
+}
+
+// Copies the token at p into a NULL-terminated string for strtod/strtof. It
+// goes in buffer when it fits and on the heap otherwise, a truncated copy
+// would round long numbers on a prefix of their digits. Returns NULL if the
+// token is empty or it can't be allocated.
+internal char *
+mho__copy_token(const char *p,
+                const char *end,
+                char *buffer)
+{
+    char                *token;
+    usize               n = 0;
+
+
+    while (p + n < end && !mho__is_space(p[n]) && p[n] != '\n' && p[n] != ',')
+        n++;
+    if (n == 0)
+        return NULL;
+
+    token = n < MHO_PARSE_MAX_TOKEN ? buffer : (char *)malloc(n + 1);
+    if (!token)
+        return NULL;
+    memcpy(token, p, n);
+    token[n] = 0;
+
+    return token;
+}
+
+// Eisel-Lemire: returns the IEEE bits (sign excluded) of the value nearest
+// to w * 10^q, for f32 if single is set and f64 otherwise
+internal u64
+mho__eisel_lemire(u64 w,
+                  s32 q,
+                  b32 single)
+{
+    const u32           mant_bits = single ? 23 : 52;
+    const s32           min_exp = single ? -127 : -1023,
+                        inf_exp = single ? 0xFF : 0x7FF;
+    const u64           prec_mask = 0xFFFFFFFFFFFFFFFFULL >> (mant_bits + 3);
+    u64                 hi,
+                        lo,
+                        hi2,
+                        mant;
+    u32                 lz,
+                        upper,
+                        shift;
+    s32                 exp2;
+    const u64           *pow5;
+
+
+    if (w == 0 || q < (single ? -65 : MHO_POW5_MIN_EXP))
+        return 0;
+    if (q > (single ? 38 : MHO_POW5_MAX_EXP))
+        return (u64)inf_exp << mant_bits;
+
+    lz = mho__clz64(w);
+    w <<= lz;
+
+    // The high product alone decides the rounding unless its low bits are
+    // all ones, then the low half of 5^q is added in
+    pow5 = mho_pow5_128 + 2 * (q - MHO_POW5_MIN_EXP);
+    lo = mho__mul128(w, pow5[0], &hi);
+    if ((hi & prec_mask) == prec_mask)
+    {
+        mho__mul128(w, pow5[1], &hi2);
+        lo += hi2;
+        hi += (hi2 > lo);
+    }
+
+    upper = (u32)(hi >> 63);
+    shift = upper + 64 - mant_bits - 3;
+    mant = hi >> shift;
+    exp2 = (((152170 + 65536) * q) >> 16) + 63 + (s32)upper - (s32)lz - min_exp;
+
+    // Subnormal
+    if (exp2 <= 0)
+    {
+        if (-exp2 + 1 >= 64)
+            return 0;
+        mant >>= -exp2 + 1;
+        mant += mant & 1;
+        mant >>= 1;
+        exp2 = mant < (1ull << mant_bits) ? 0 : 1;
+
+        return ((u64)exp2 << mant_bits) | (mant & ((1ull << mant_bits) - 1));
+    }
+
+    // Exactly halfway between two floats: round to even
+    if (lo <= 1 && q >= (single ? -17 : -4) && q <= (single ? 10 : 23) && (mant & 3) == 1 &&
+        (mant << shift) == hi)
+        mant &= ~1ull;
+
+    mant += mant & 1;
+    mant >>= 1;
+    if (mant >= (2ull << mant_bits))
+    {
+        mant = 1ull << mant_bits;
+        exp2++;
+    }
+    mant &= ~(1ull << mant_bits);
+
+    if (exp2 >= inf_exp)
+        return (u64)inf_exp << mant_bits;
+
+    return ((u64)exp2 << mant_bits) | mant;
+}
+
+b32
+mho_parse_f64(const char **str,
+              const char *end,
+              f64 *out)
+{
+    char                buffer[MHO_PARSE_MAX_TOKEN];
+    char                *token,
+                        *tail;
+    const char          *p;
+    u64                 mant,
+                        bits;
+    s32                 e;
+    b32                 neg,
+                        truncated,
+                        ret;
+
+
+    p = mho__scan_decimal(*str, end, &neg, &mant, &e, &truncated);
+    if (p)
+    {
+        if (!truncated && mant <= (1ull << 53) && e >= -22 && e <= 22)
+        {
+            *out = e < 0 ? (f64)mant / mho_pow10_f64[-e] : (f64)mant * mho_pow10_f64[e];
+            if (neg)
+                *out = -*out;
+            *str = p;
+
+            return TRUE;
+        }
+
+        // Dropped digits only matter if they could push the value across a
+        // rounding boundary
+        bits = mho__eisel_lemire(mant, e, FALSE);
+        if (!truncated || bits == mho__eisel_lemire(mant + 1, e, FALSE))
+        {
+            bits |= (u64)neg << 63;
+            memcpy(out, &bits, sizeof(f64));
+            *str = p;
+
+            return TRUE;
+        }
+    }
+
+    token = mho__copy_token(*str, end, buffer);
+    if (!token)
+        return FALSE;
+    *out = strtod(token, &tail);
+    ret = (tail != token);
+    if (ret)
+        *str += tail - token;
+    if (token != buffer)
+        free(token);
+
+    return ret;
+}
+
+b32
+mho_parse_f32(const char **str,
+              const char *end,
+              f32 *out)
+{
+    char                buffer[MHO_PARSE_MAX_TOKEN];
+    char                *token,
+                        *tail;
+    const char          *p;
+    u64                 mant;
+    s32                 e;
+    b32                 neg,
+                        truncated,
+                        ret;
+    f32                 f;
+    u32                 bits;
+
+
+    p = mho__scan_decimal(*str, end, &neg, &mant, &e, &truncated);
+    if (p)
+    {
+        // Exact single-precision operands, so one correctly rounded operation
+        if (!truncated && mant <= (1u << 24) && e >= -10 && e <= 10)
+        {
+            f = e < 0 ? (f32)mant / mho_pow10_f32[-e] : (f32)mant * mho_pow10_f32[e];
+            *out = neg ? -f : f;
+            *str = p;
+
+            return TRUE;
+        }
+
+        bits = (u32)mho__eisel_lemire(mant, e, TRUE);
+        if (!truncated || bits == (u32)mho__eisel_lemire(mant + 1, e, TRUE))
+        {
+            bits |= (u32)neg << 31;
+            memcpy(out, &bits, sizeof(f32));
+            *str = p;
+
+            return TRUE;
+        }
+    }
+
+    token = mho__copy_token(*str, end, buffer);
+    if (!token)
+        return FALSE;
+    *out = strtof(token, &tail);
+    ret = (tail != token);
+    if (ret)
+        *str += tail - token;
+    if (token != buffer)
+        free(token);
+
+    return ret;
+}
+
+//-------------------- NUMBER FORMATTING ----------------//
+
+// Integers are written two digits at a time off a pair table. Floats use
+// Grisu2: the value and its rounding interval are scaled by a cached power
+// of ten into a 64-bit fixed point window, and digits are generated until
+// they fall inside the interval. The output always parses back to the same
+// value and is the shortest such string in all but a tiny fraction of cases.
+
+global const char mho_digit_pairs[] =
+    "0001020304050607080910111213141516171819202122232425262728293031323334353637383940414243444546474849"
+    "5051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+
+global const u64 mho_pow10_u64[] =
+{
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL,
+    1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+    100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL,
+    1000000000000000000ULL, 10000000000000000000ULL
+};
+
+// Floating point value f * 2^e with a 64-bit significand
+typedef struct _TAG_mho_diyfp
+{
+    u64                 f;
+    s32                 e;
+} mho_diyfp_t;
+
+// Normalized 10^k for k = -348, -340, ..., 340
+global const mho_diyfp_t mho_cached_pow10[] =
+{
+    { 0xFA8FD5A0081C0288ULL, -1220 },
+    { 0xBAAEE17FA23EBF76ULL, -1193 },
+    { 0x8B16FB203055AC76ULL, -1166 },
+    { 0xCF42894A5DCE35EAULL, -1140 },
+    { 0x9A6BB0AA55653B2DULL, -1113 },
+    { 0xE61ACF033D1A45DFULL, -1087 },
+    { 0xAB70FE17C79AC6CAULL, -1060 },
+    { 0xFF77B1FCBEBCDC4FULL, -1034 },
+    { 0xBE5691EF416BD60CULL, -1007 },
+    { 0x8DD01FAD907FFC3CULL,  -980 },
+    { 0xD3515C2831559A83ULL,  -954 },
+    { 0x9D71AC8FADA6C9B5ULL,  -927 },
+    { 0xEA9C227723EE8BCBULL,  -901 },
+    { 0xAECC49914078536DULL,  -874 },
+    { 0x823C12795DB6CE57ULL,  -847 },
+    { 0xC21094364DFB5637ULL,  -821 },
+    { 0x9096EA6F3848984FULL,  -794 },
+    { 0xD77485CB25823AC7ULL,  -768 },
+    { 0xA086CFCD97BF97F4ULL,  -741 },
+    { 0xEF340A98172AACE5ULL,  -715 },
+    { 0xB23867FB2A35B28EULL,  -688 },
+    { 0x84C8D4DFD2C63F3BULL,  -661 },
+    { 0xC5DD44271AD3CDBAULL,  -635 },
+    { 0x936B9FCEBB25C996ULL,  -608 },
+    { 0xDBAC6C247D62A584ULL,  -582 },
+    { 0xA3AB66580D5FDAF6ULL,  -555 },
+    { 0xF3E2F893DEC3F126ULL,  -529 },
+    { 0xB5B5ADA8AAFF80B8ULL,  -502 },
+    { 0x87625F056C7C4A8BULL,  -475 },
+    { 0xC9BCFF6034C13053ULL,  -449 },
+    { 0x964E858C91BA2655ULL,  -422 },
+    { 0xDFF9772470297EBDULL,  -396 },
+    { 0xA6DFBD9FB8E5B88FULL,  -369 },
+    { 0xF8A95FCF88747D94ULL,  -343 },
+    { 0xB94470938FA89BCFULL,  -316 },
+    { 0x8A08F0F8BF0F156BULL,  -289 },
+    { 0xCDB02555653131B6ULL,  -263 },
+    { 0x993FE2C6D07B7FACULL,  -236 },
+    { 0xE45C10C42A2B3B06ULL,  -210 },
+    { 0xAA242499697392D3ULL,  -183 },
+    { 0xFD87B5F28300CA0EULL,  -157 },
+    { 0xBCE5086492111AEBULL,  -130 },
+    { 0x8CBCCC096F5088CCULL,  -103 },
+    { 0xD1B71758E219652CULL,   -77 },
+    { 0x9C40000000000000ULL,   -50 },
+    { 0xE8D4A51000000000ULL,   -24 },
+    { 0xAD78EBC5AC620000ULL,     3 },
+    { 0x813F3978F8940984ULL,    30 },
+    { 0xC097CE7BC90715B3ULL,    56 },
+    { 0x8F7E32CE7BEA5C70ULL,    83 },
+    { 0xD5D238A4ABE98068ULL,   109 },
+    { 0x9F4F2726179A2245ULL,   136 },
+    { 0xED63A231D4C4FB27ULL,   162 },
+    { 0xB0DE65388CC8ADA8ULL,   189 },
+    { 0x83C7088E1AAB65DBULL,   216 },
+    { 0xC45D1DF942711D9AULL,   242 },
+    { 0x924D692CA61BE758ULL,   269 },
+    { 0xDA01EE641A708DEAULL,   295 },
+    { 0xA26DA3999AEF774AULL,   322 },
+    { 0xF209787BB47D6B85ULL,   348 },
+    { 0xB454E4A179DD1877ULL,   375 },
+    { 0x865B86925B9BC5C2ULL,   402 },
+    { 0xC83553C5C8965D3DULL,   428 },
+    { 0x952AB45CFA97A0B3ULL,   455 },
+    { 0xDE469FBD99A05FE3ULL,   481 },
+    { 0xA59BC234DB398C25ULL,   508 },
+    { 0xF6C69A72A3989F5CULL,   534 },
+    { 0xB7DCBF5354E9BECEULL,   561 },
+    { 0x88FCF317F22241E2ULL,   588 },
+    { 0xCC20CE9BD35C78A5ULL,   614 },
+    { 0x98165AF37B2153DFULL,   641 },
+    { 0xE2A0B5DC971F303AULL,   667 },
+    { 0xA8D9D1535CE3B396ULL,   694 },
+    { 0xFB9B7CD9A4A7443CULL,   720 },
+    { 0xBB764C4CA7A44410ULL,   747 },
+    { 0x8BAB8EEFB6409C1AULL,   774 },
+    { 0xD01FEF10A657842CULL,   800 },
+    { 0x9B10A4E5E9913129ULL,   827 },
+    { 0xE7109BFBA19C0C9DULL,   853 },
+    { 0xAC2820D9623BF429ULL,   880 },
+    { 0x80444B5E7AA7CF85ULL,   907 },
+    { 0xBF21E44003ACDD2DULL,   933 },
+    { 0x8E679C2F5E44FF8FULL,   960 },
+    { 0xD433179D9C8CB841ULL,   986 },
+    { 0x9E19DB92B4E31BA9ULL,  1013 },
+    { 0xEB96BF6EBADF77D9ULL,  1039 },
+    { 0xAF87023B9BF0EE6BULL,  1066 },
+};
+
+internal u32
+mho__u64_digit_cnt(u64 val)
+{
+    u32                 n = 1;
+
+
+    for (;;)
+    {
+        if (val < 10)
+            return n;
+        if (val < 100)
+            return n + 1;
+        if (val < 1000)
+            return n + 2;
+        if (val < 10000)
+            return n + 3;
+        val /= 10000;
+        n += 4;
+    }
+}
+
+// Writes the digits of val backwards, ending right before end
+internal void
+mho__write_digits(char *end,
+                  u64 val)
+{
+    u32                 idx;
+
+
+    while (val >= 100)
+    {
+        idx = (u32)(val % 100) * 2;
+        val /= 100;
+        *--end = mho_digit_pairs[idx + 1];
+        *--end = mho_digit_pairs[idx];
+    }
+
+    if (val >= 10)
+    {
+        *--end = mho_digit_pairs[val * 2 + 1];
+        *--end = mho_digit_pairs[val * 2];
+    }
+    else
+    {
+        *--end = (char)('0' + val);
+    }
+}
+
+u32
+mho_u64_to_str(u64 val,
+               char *buf)
+{
+    u32                 n = mho__u64_digit_cnt(val);
+
+
+    mho__write_digits(buf + n, val);
+    buf[n] = 0;
+
+    return n;
+}
+
+u32
+mho_s64_to_str(s64 val,
+               char *buf)
+{
+    if (val < 0)
+    {
+        buf[0] = '-';
+        return 1 + mho_u64_to_str(0 - (u64)val, buf + 1);
+    }
+
+    return mho_u64_to_str((u64)val, buf);
+}
+
+// Product rounded to the upper 64 bits
+internal mho_diyfp_t
+mho__diyfp_mul(mho_diyfp_t a,
+               mho_diyfp_t b)
+{
+    mho_diyfp_t         r;
+    u64                 lo;
+
+
+    lo = mho__mul128(a.f, b.f, &r.f);
+    r.f += lo >> 63;
+    r.e = a.e + b.e + 64;
+
+    return r;
+}
+
+internal mho_diyfp_t
+mho__diyfp_norm(mho_diyfp_t a)
+{
+    u32                 s = mho__clz64(a.f);
+
+
+    a.f <<= s;
+    a.e -= (s32)s;
+
+    return a;
+}
+
+// Moves the last digit down while that gets closer to the exact value and
+// stays inside the interval
+internal void
+mho__grisu_round(char *digits,
+                 u32 len,
+                 u64 delta,
+                 u64 rest,
+                 u64 ten_kappa,
+                 u64 wp_w)
+{
+    while (rest < wp_w && delta - rest >= ten_kappa &&
+           (rest + ten_kappa < wp_w || wp_w - rest > rest + ten_kappa - wp_w))
+    {
+        digits[len - 1]--;
+        rest += ten_kappa;
+    }
+}
+
+// Generates the digits of w, stopping once they are within delta of the
+// interval's upper bound mp. *k gets the power of ten of the last digit.
+internal u32
+mho__grisu_digits(mho_diyfp_t w,
+                  mho_diyfp_t mp,
+                  u64 delta,
+                  char *digits,
+                  s32 *k)
+{
+    const u32           shift = (u32)-mp.e;
+    const u64           one = 1ULL << shift,
+                        wp_w = mp.f - w.f;
+    u32                 p1 = (u32)(mp.f >> shift),
+                        len = 0,
+                        d;
+    u64                 p2 = mp.f & (one - 1),
+                        rest;
+    s32                 kappa = (s32)mho__u64_digit_cnt(p1);
+
+
+    // Integral part
+    while (kappa > 0)
+    {
+        d = p1 / (u32)mho_pow10_u64[kappa - 1];
+        p1 %= (u32)mho_pow10_u64[kappa - 1];
+        if (d || len)
+            digits[len++] = (char)('0' + d);
+        kappa--;
+
+        rest = ((u64)p1 << shift) + p2;
+        if (rest <= delta)
+        {
+            *k += kappa;
+            mho__grisu_round(digits, len, delta, rest, mho_pow10_u64[kappa] << shift, wp_w);
+            return len;
+        }
+    }
+
+    // Fractional part
+    for (;;)
+    {
+        p2 *= 10;
+        delta *= 10;
+        d = (u32)(p2 >> shift);
+        if (d || len)
+            digits[len++] = (char)('0' + d);
+        p2 &= one - 1;
+        kappa--;
+
+        if (p2 < delta)
+        {
+            *k += kappa;
+            mho__grisu_round(digits, len, delta, p2, one, wp_w * mho_pow10_u64[-kappa]);
+            return len;
+        }
+    }
+}
+
+// Shortest digits of f * 2^e (the value is digits * 10^*k). lower_closer is
+// set for powers of two, whose lower neighbour is half as far as the upper.
+internal u32
+mho__grisu2(u64 f,
+            s32 e,
+            b32 lower_closer,
+            char *digits,
+            s32 *k)
+{
+    mho_diyfp_t         v,
+                        plus,
+                        minus,
+                        c,
+                        w,
+                        wp,
+                        wm;
+    f64                 dk;
+    s32                 ki;
+    u32                 idx;
+
+
+    v.f = f;
+    v.e = e;
+    plus.f = (f << 1) + 1;
+    plus.e = e - 1;
+    minus.f = lower_closer ? (f << 2) - 1 : (f << 1) - 1;
+    minus.e = lower_closer ? e - 2 : e - 1;
+    v = mho__diyfp_norm(v);
+    plus = mho__diyfp_norm(plus);
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+
+    // Cached power that brings the upper bound's exponent into [-60, -32]
+    dk = (-61 - plus.e) * 0.30102999566398114 + 347;
+    ki = (s32)dk;
+    if (ki < dk)
+        ki++;
+    idx = (u32)(ki >> 3) + 1;
+    *k = -(-348 + (s32)idx * 8);
+    c = mho_cached_pow10[idx];
+
+    w = mho__diyfp_mul(v, c);
+    wp = mho__diyfp_mul(plus, c);
+    wm = mho__diyfp_mul(minus, c);
+    wm.f++;
+    wp.f--;
+
+    return mho__grisu_digits(w, wp, wp.f - wm.f, digits, k);
+}
+
+// Lays out the digits (value = digits * 10^k) as an integer, a decimal or
+// in exponent notation, whichever is the natural fit
+internal u32
+mho__format_digits(char *buf,
+                   const char *digits,
+                   s32 len,
+                   s32 k)
+{
+    s32                 kk = len + k,   // 10^(kk - 1) <= value < 10^kk
+                        n;
+
+
+    if (k >= 0 && kk <= 21)
+    {
+        memcpy(buf, digits, (usize)len);
+        memset(buf + len, '0', (usize)k);
+
+        return (u32)kk;
+    }
+    if (kk > 0 && kk <= 21)
+    {
+        memcpy(buf, digits, (usize)kk);
+        buf[kk] = '.';
+        memcpy(buf + kk + 1, digits + kk, (usize)(len - kk));
+
+        return (u32)len + 1;
+    }
+    if (kk > -6 && kk <= 0)
+    {
+        buf[0] = '0';
+        buf[1] = '.';
+        memset(buf + 2, '0', (usize)-kk);
+        memcpy(buf + 2 - kk, digits, (usize)len);
+
+        return (u32)(2 - kk + len);
+    }
+
+    n = 0;
+    buf[n++] = digits[0];
+    if (len > 1)
+    {
+        buf[n++] = '.';
+        memcpy(buf + n, digits + 1, (usize)len - 1);
+        n += len - 1;
+    }
+    buf[n++] = 'e';
+
+    return (u32)n + mho_s64_to_str(kk - 1, buf + n);
+}
+
+// Formats a float given as its biased exponent and fraction bits
+internal u32
+mho__float_to_str(u32 biased,
+                  u64 frac,
+                  u32 mant_bits,
+                  u32 exp_max,
+                  b32 neg,
+                  char *buf)
+{
+    char                digits[24];
+    s32                 k,
+                        bias = (s32)(exp_max >> 1) + (s32)mant_bits;
+    u32                 n = 0,
+                        len;
+
+
+    if (biased == exp_max)
+    {
+        if (frac)
+        {
+            memcpy(buf, "nan", 4);
+            return 3;
+        }
+        if (neg)
+            buf[n++] = '-';
+        memcpy(buf + n, "inf", 4);
+
+        return n + 3;
+    }
+
+    if (neg)
+        buf[n++] = '-';
+    if (!biased && !frac)
+    {
+        buf[n++] = '0';
+        buf[n] = 0;
+
+        return n;
+    }
+
+    if (biased)
+        len = mho__grisu2(frac | (1ULL << mant_bits), (s32)biased - bias, biased > 1 && !frac, digits, &k);
+    else
+        len = mho__grisu2(frac, 1 - bias, FALSE, digits, &k);
+
+    n += mho__format_digits(buf + n, digits, (s32)len, k);
+    buf[n] = 0;
+
+    return n;
+}
+
+u32
+mho_f64_to_str(f64 val,
+               char *buf)
+{
+    u64                 bits;
+
+
+    memcpy(&bits, &val, sizeof(f64));
+
+    return mho__float_to_str((u32)(bits >> 52) & 0x7FF, bits & ((1ULL << 52) - 1), 52, 0x7FF, (b32)(bits >> 63), buf);
+}
+
+u32
+mho_f32_to_str(f32 val,
+               char *buf)
+{
+    u32                 bits;
+
+
+    memcpy(&bits, &val, sizeof(f32));
+
+    return mho__float_to_str((bits >> 23) & 0xFF, bits & ((1u << 23) - 1), 23, 0xFF, (b32)(bits >> 31), buf);
+}
+
+//-------------------- MESH LOADING ----------------//
+
+#define MHO_PARSE_CHUNK     (1024 * 1024)   // Target size of the chunks parsed in parallel
+
+// Record kinds counted per chunk
+#define MHO_OBJ_V           0
+#define MHO_OBJ_VT          1
+#define MHO_OBJ_VN          2
+#define MHO_OBJ_TRI         3
+#define MHO_OBJ_KINDS       4
+
+// A piece of the file that starts at the beginning of a line
+typedef struct _TAG_mho_parse_chunk
+{
+    const char          *start,
+                        *end;
+    u64                 counts[MHO_OBJ_KINDS],
+                        bases[MHO_OBJ_KINDS];   // Sum of the counts of every earlier chunk
+} mho_parse_chunk_t;
+
+// Shared state of a parallel parse. Every chunk is counted in a first pass,
+// so that the second can write each record straight to its final index.
+typedef struct _TAG_mho_parse_ctx
+{
+    mho_parse_chunk_t   *chunks;
+    u32                 chunk_cnt;
+    b32                 counting,
+                        is_obj;
+    u64                 totals[MHO_OBJ_KINDS];
+    mho_obj_t           *obj;
+    f32                 *floats;
+    mho__atomic_u32     next;
+    mho__atomic_u32     failed;
+} mho_parse_ctx_t;
+
+internal const char *
+mho__skip_space(const char *p,
+                const char *end)
+{
+    while (p < end && mho__is_space(*p))
+        p++;
+
+    return p;
+}
+
+internal const char *
+mho__next_line(const char *p,
+               const char *end)
+{
+    p = (const char *)memchr(p, '\n', (usize)(end - p));
+
+    return p ? p + 1 : end;
+}
+
+// Counts the whitespace (or comma) separated tokens up to the end of the line
+internal u64
+mho__count_tokens(const char *p,
+                  const char *end)
+{
+    u64                 cnt = 0;
+
+
+    for (;;)
+    {
+        p = mho__skip_space(p, end);
+        if (p >= end || *p == '\n')
+            return cnt;
+        cnt++;
+        while (p < end && !mho__is_space(*p) && *p != '\n' && *p != ',')
+            p++;
+        if (p < end && *p == ',')
+            p++;
+    }
+}
+
+// Resolves a 1-based (or negative, relative) OBJ index against the number of
+// elements seen so far, returning FALSE if it's out of range
+internal b32
+mho__obj_index(const char **str,
+               const char *end,
+               u64 seen,
+               u64 total,
+               u32 *out)
+{
+    const char          *p = *str;
+    s64                 idx = 0;
+    b32                 neg = FALSE;
+
+
+    if (p < end && *p == '-')
+    {
+        neg = TRUE;
+        p++;
+    }
+    if (p >= end || !mho__is_digit(*p))
+        return FALSE;
+    for (; p < end && mho__is_digit(*p); p++)
+    {
+        // Out of range either way, and stops before idx can overflow
+        idx = idx * 10 + (*p - '0');
+        if ((u64)idx > total)
+            return FALSE;
+    }
+    *str = p;
+
+    idx = neg ? (s64)seen - idx : idx - 1;
+    if (idx < 0 || (u64)idx >= total)
+        return FALSE;
+    *out = (u32)idx;
+
+    return TRUE;
+}
+
+// Parses one face corner (v, v/vt, v//vn or v/vt/vn)
+internal b32
+mho__obj_corner(const char **str,
+                const char *end,
+                const u64 *seen,
+                const u64 *totals,
+                mho_obj_index_t *corner)
+{
+    const char          *p = *str;
+
+
+    corner->vt = MHO_OBJ_NONE;
+    corner->vn = MHO_OBJ_NONE;
+    if (!mho__obj_index(&p, end, seen[MHO_OBJ_V], totals[MHO_OBJ_V], &corner->v))
+        return FALSE;
+    if (p < end && *p == '/')
+    {
+        p++;
+        if (p < end && *p != '/' && !mho__obj_index(&p, end, seen[MHO_OBJ_VT], totals[MHO_OBJ_VT], &corner->vt))
+            return FALSE;
+        if (p < end && *p == '/')
+        {
+            p++;
+            if (!mho__obj_index(&p, end, seen[MHO_OBJ_VN], totals[MHO_OBJ_VN], &corner->vn))
+                return FALSE;
+        }
+    }
+    *str = p;
+
+    return TRUE;
+}
+
+// Parses n floats separated by whitespace
+internal b32
+mho__parse_floats_n(const char **str,
+                    const char *end,
+                    f32 *out,
+                    u32 n)
+{
+    u32                 i;
+
+
+    for (i = 0; i < n; i++)
+    {
+        *str = mho__skip_space(*str, end);
+        if (!mho_parse_f32(str, end, &out[i]))
+            return FALSE;
+    }
+
+    return TRUE;
+}
+
+internal b32
+mho__obj_parse_chunk(mho_parse_ctx_t *ctx,
+                     mho_parse_chunk_t *chunk)
+{
+    const char          *p = chunk->start,
+                        *end = chunk->end,
+                        *line_end,
+                        *face_end;
+    u64                 seen[MHO_OBJ_KINDS],
+                        corners,
+                        i;
+    mho_obj_index_t     first,
+                        prev,
+                        cur,
+                        *tri;
+    mho_obj_t           *obj = ctx->obj;
+    f32                 *uv;
+
+
+    for (i = 0; i < MHO_OBJ_KINDS; i++)
+        seen[i] = ctx->counting ? 0 : chunk->bases[i];
+
+    for (; p < end; p = line_end)
+    {
+        line_end = mho__next_line(p, end);
+        p = mho__skip_space(p, line_end);
+        if (line_end - p < 3)
+            continue;
+
+        if (p[0] == 'v' && mho__is_space(p[1]))
+        {
+            p += 1;
+            if (!ctx->counting && !mho__parse_floats_n(&p, line_end, obj->positions[seen[MHO_OBJ_V]].elements, 3))
+                return FALSE;
+            seen[MHO_OBJ_V]++;
+        }
+        else if (p[0] == 'v' && p[1] == 't' && mho__is_space(p[2]))
+        {
+            // vt u [v] [w], a missing v is 0 and w is ignored
+            p += 2;
+            if (!ctx->counting)
+            {
+                uv = obj->uvs[seen[MHO_OBJ_VT]].elements;
+                uv[1] = 0.0f;
+                if (!mho__parse_floats_n(&p, line_end, uv, 1))
+                    return FALSE;
+                p = mho__skip_space(p, line_end);
+                if (p < line_end && *p != '\n' && *p != '#' && !mho__parse_floats_n(&p, line_end, uv + 1, 1))
+                    return FALSE;
+            }
+            seen[MHO_OBJ_VT]++;
+        }
+        else if (p[0] == 'v' && p[1] == 'n' && mho__is_space(p[2]))
+        {
+            p += 2;
+            if (!ctx->counting && !mho__parse_floats_n(&p, line_end, obj->normals[seen[MHO_OBJ_VN]].elements, 3))
+                return FALSE;
+            seen[MHO_OBJ_VN]++;
+        }
+        else if (p[0] == 'f' && mho__is_space(p[1]))
+        {
+            // The corners stop at an inline comment
+            face_end = (const char *)memchr(p, '#', (usize)(line_end - p));
+            if (!face_end)
+                face_end = line_end;
+
+            // Polygons are triangulated as a fan around their first corner
+            if (ctx->counting)
+            {
+                corners = mho__count_tokens(p + 1, face_end);
+                if (corners < 3)
+                    return FALSE;
+                seen[MHO_OBJ_TRI] += corners - 2;
+                continue;
+            }
+
+            p++;
+            for (corners = 0;; corners++)
+            {
+                p = mho__skip_space(p, face_end);
+                if (p >= face_end || *p == '\n')
+                    break;
+                // Corners must line up with the tokens counted in the first pass
+                if (!mho__obj_corner(&p, face_end, seen, ctx->totals, &cur) ||
+                    (p < face_end && !mho__is_space(*p) && *p != '\n'))
+                    return FALSE;
+
+                if (corners == 0)
+                {
+                    first = cur;
+                }
+                else if (corners >= 2)
+                {
+                    tri = &obj->indices[3 * seen[MHO_OBJ_TRI]++];
+                    tri[0] = first;
+                    tri[1] = prev;
+                    tri[2] = cur;
+                }
+                prev = cur;
+            }
+        }
+    }
+
+    if (ctx->counting)
+    {
+        for (i = 0; i < MHO_OBJ_KINDS; i++)
+            chunk->counts[i] = seen[i];
+    }
+
+    return TRUE;
+}
+
+internal b32
+mho__floats_parse_chunk(mho_parse_ctx_t *ctx,
+                        mho_parse_chunk_t *chunk)
+{
+    const char          *p = chunk->start,
+                        *end = chunk->end,
+                        *line_end;
+    u64                 seen = chunk->bases[0];
+
+
+    for (; p < end; p = line_end)
+    {
+        line_end = mho__next_line(p, end);
+        p = mho__skip_space(p, line_end);
+        if (p < line_end && *p == '#')
+            continue;
+
+        if (ctx->counting)
+        {
+            chunk->counts[0] += mho__count_tokens(p, line_end);
+            continue;
+        }
+
+        for (;;)
+        {
+            p = mho__skip_space(p, line_end);
+            if (p >= line_end || *p == '\n')
+                break;
+            if (!mho_parse_f32(&p, line_end, &ctx->floats[seen++]))
+                return FALSE;
+            if (p < line_end && *p == ',')
+                p++;
+            else if (p < line_end && !mho__is_space(*p) && *p != '\n')
+                return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+internal
+MHO__THREAD_PROC(mho__parse_proc, arg)
+{
+    mho_parse_ctx_t     *ctx = (mho_parse_ctx_t *)arg;
+    mho_parse_chunk_t   *chunk;
+    u32                 i;
+    b32                 ok;
+
+
+    while ((i = mho__atomic_fetch_add(&ctx->next, 1)) < ctx->chunk_cnt)
+    {
+        chunk = &ctx->chunks[i];
+        ok = ctx->is_obj ? mho__obj_parse_chunk(ctx, chunk) : mho__floats_parse_chunk(ctx, chunk);
+        if (!ok)
+            mho__atomic_store(&ctx->failed, 1);
+    }
+
+    MHO__THREAD_RETURN;
+}
+
+// Splits a buffer into chunks at line boundaries and runs the counting pass
+// over them, leaving the totals and per-chunk bases in ctx
+internal b32
+mho__parse_count(mho_parse_ctx_t *ctx,
+                 const char *data,
+                 u64 len,
+                 u32 thread_cnt)
+{
+    const char          *p = data,
+                        *end = data + len;
+    u32                 i,
+                        k;
+
+
+    ctx->chunk_cnt = (u32)mho_max((len + MHO_PARSE_CHUNK - 1) / MHO_PARSE_CHUNK, 1);
+    ctx->chunks = (mho_parse_chunk_t *)calloc(ctx->chunk_cnt, sizeof(mho_parse_chunk_t));
+    if (!ctx->chunks)
+        return FALSE;
+
+    for (i = 0; i < ctx->chunk_cnt; i++)
+    {
+        ctx->chunks[i].start = p;
+        p = (i == ctx->chunk_cnt - 1) ? end : data + (len * (i + 1)) / ctx->chunk_cnt;
+        if (p < ctx->chunks[i].start)
+            p = ctx->chunks[i].start;
+        p = p > data && p < end && p[-1] != '\n' ? mho__next_line(p, end) : p;
+        ctx->chunks[i].end = p;
+    }
+
+    if (thread_cnt == 0)
+        thread_cnt = mho__cpu_count();
+    thread_cnt = mho_max(mho_min(thread_cnt, ctx->chunk_cnt), 1);
+
+    ctx->counting = TRUE;
+    mho__atomic_init(&ctx->next, 0);
+    mho__atomic_init(&ctx->failed, 0);
+    mho__run_threads(mho__parse_proc, ctx, thread_cnt);
+    if (mho__atomic_load(&ctx->failed))
+        return FALSE;
+
+    for (i = 0; i < ctx->chunk_cnt; i++)
+    {
+        for (k = 0; k < MHO_OBJ_KINDS; k++)
+        {
+            ctx->chunks[i].bases[k] = ctx->totals[k];
+            ctx->totals[k] += ctx->chunks[i].counts[k];
+        }
+    }
+
+    return TRUE;
+}
+
+// Runs the second pass of a parse, once the outputs have been allocated
+internal b32
+mho__parse_fill(mho_parse_ctx_t *ctx,
+                u32 thread_cnt)
+{
+    if (thread_cnt == 0)
+        thread_cnt = mho__cpu_count();
+    thread_cnt = mho_max(mho_min(thread_cnt, ctx->chunk_cnt), 1);
+
+    ctx->counting = FALSE;
+    mho__atomic_store(&ctx->next, 0);
+    mho__run_threads(mho__parse_proc, ctx, thread_cnt);
+
+    return !mho__atomic_load(&ctx->failed);
+}
+
+// Creates an array of cnt elements (left NULL when empty)
+internal void *
+mho__parse_arr(usize sz,
+               u64 cnt,
+               b32 *ok)
+{
+    void                *arr;
+
+
+    if (cnt == 0)
+        return NULL;
+
+    arr = mho__arr_create(sz, (usize)cnt, 0, NULL);
+    if (arr)
+        mho_arr_head(arr)->size = cnt;
+    else
+        *ok = FALSE;
+
+    return arr;
+}
+
+b32
+mho_obj_load(const char *filename,
+             u32 thread_cnt,
+             mho_obj_t *obj)
+{
+    mho_parse_ctx_t     ctx;
+    mho_fmap_t          map;
+    b32                 ok;
+
+
+    memset(obj, 0, sizeof(mho_obj_t));
+    if (!mho_file_map(filename, MHO_FMAP_SEQUENTIAL | MHO_FMAP_WILLNEED, &map))
+        return FALSE;
+
+    memset(&ctx, 0, sizeof(mho_parse_ctx_t));
+    ctx.is_obj = TRUE;
+    ctx.obj = obj;
+    ok = mho__parse_count(&ctx, (const char *)map.data, map.len, thread_cnt) &&
+         ctx.totals[MHO_OBJ_V] <= MHO_OBJ_NONE && ctx.totals[MHO_OBJ_VT] <= MHO_OBJ_NONE &&
+         ctx.totals[MHO_OBJ_VN] <= MHO_OBJ_NONE;
+    if (ok)
+    {
+        obj->positions = (mho_vec3_t *)mho__parse_arr(sizeof(mho_vec3_t), ctx.totals[MHO_OBJ_V], &ok);
+        obj->uvs = (mho_vec2_t *)mho__parse_arr(sizeof(mho_vec2_t), ctx.totals[MHO_OBJ_VT], &ok);
+        obj->normals = (mho_vec3_t *)mho__parse_arr(sizeof(mho_vec3_t), ctx.totals[MHO_OBJ_VN], &ok);
+        obj->indices = (mho_obj_index_t *)mho__parse_arr(sizeof(mho_obj_index_t), 3 * ctx.totals[MHO_OBJ_TRI], &ok);
+    }
+    if (ok)
+        ok = mho__parse_fill(&ctx, thread_cnt);
+
+    if (!ok)
+    {
+        fprintf(stderr, "Could not parse OBJ file: %s\n", filename);
+        mho_obj_free(obj);
+    }
+    free(ctx.chunks);
+    mho_file_unmap(&map);
+
+    return ok;
+}
+
+void
+mho_obj_free(mho_obj_t *obj)
+{
+    mho_arr_free(obj->positions);
+    mho_arr_free(obj->uvs);
+    mho_arr_free(obj->normals);
+    mho_arr_free(obj->indices);
+    memset(obj, 0, sizeof(mho_obj_t));
+}
+
+// Parses a file of whitespace separated floats into an array of elements of
+// width floats each
+internal void *
+mho__file_read_floats(const char *filename,
+                      u32 thread_cnt,
+                      u32 width)
+{
+    mho_parse_ctx_t     ctx;
+    mho_fmap_t          map;
+    void                *arr = NULL;
+    b32                 ok;
+
+
+    if (!mho_file_map(filename, MHO_FMAP_SEQUENTIAL | MHO_FMAP_WILLNEED, &map))
+        return NULL;
+
+    memset(&ctx, 0, sizeof(mho_parse_ctx_t));
+    ok = mho__parse_count(&ctx, (const char *)map.data, map.len, thread_cnt) && ctx.totals[0] % width == 0;
+    if (ok)
+    {
+        arr = mho__parse_arr(width * sizeof(f32), ctx.totals[0] / width, &ok);
+        ctx.floats = (f32 *)arr;
+    }
+    if (ok && arr)
+        ok = mho__parse_fill(&ctx, thread_cnt);
+
+    if (!ok)
+    {
+        fprintf(stderr, "Could not parse float file: %s\n", filename);
+        mho__arr_free(arr, width * sizeof(f32));
+        arr = NULL;
+    }
+    free(ctx.chunks);
+    mho_file_unmap(&map);
+
+    return arr;
+}
+
+mho_arr(f32)
+mho_file_read_floats(const char *filename,
+                     u32 thread_cnt)
+{
+    return (f32 *)mho__file_read_floats(filename, thread_cnt, 1);
+}
+
+mho_arr(mho_vec2_t)
+mho_file_read_vec2(const char *filename,
+                   u32 thread_cnt)
+{
+    return (mho_vec2_t *)mho__file_read_floats(filename, thread_cnt, 2);
+}
+
+mho_arr(mho_vec3_t)
+mho_file_read_vec3(const char *filename,
+                   u32 thread_cnt)
+{
+    return (mho_vec3_t *)mho__file_read_floats(filename, thread_cnt, 3);
+}
+
+
+//-------------------- CSV WRITING ----------------//
+
+#define MHO_CSV_CHUNK_ROWS  (16 * 1024)     // Rows formatted by a worker at a time
+#define MHO_CSV_F32_MAX     24              // Longest formatted f32 plus its separator
+
+// Shared state of a CSV write. Each round formats chunk_cnt chunks into
+// their own buffers in parallel, which are then written out in order.
+typedef struct _TAG_mho_csv_ctx
+{
+    const f32           *data;
+    u64                 row_cnt,
+                        first_chunk;
+    u32                 col_cnt,
+                        chunk_cnt;
+    char                **buffers;
+    usize               *lens;
+    mho__atomic_u32     next;
+} mho_csv_ctx_t;
+
+internal
+MHO__THREAD_PROC(mho__csv_proc, arg)
+{
+    mho_csv_ctx_t       *ctx = (mho_csv_ctx_t *)arg;
+    const f32           *src;
+    char                *dst;
+    u64                 row,
+                        row_end;
+    u32                 i,
+                        col;
+
+
+    while ((i = mho__atomic_fetch_add(&ctx->next, 1)) < ctx->chunk_cnt)
+    {
+        row = (ctx->first_chunk + i) * MHO_CSV_CHUNK_ROWS;
+        row_end = mho_min(row + MHO_CSV_CHUNK_ROWS, ctx->row_cnt);
+        src = ctx->data + row * ctx->col_cnt;
+        dst = ctx->buffers[i];
+
+        for (; row < row_end; row++)
+        {
+            for (col = 0; col < ctx->col_cnt; col++)
+            {
+                dst += mho_f32_to_str(*src++, dst);
+                *dst++ = ',';
+            }
+            dst[-1] = '\n';
+        }
+        ctx->lens[i] = (usize)(dst - ctx->buffers[i]);
+    }
+
+    MHO__THREAD_RETURN;
+}
+
+b32
+mho_csv_write_f32(const char *filename,
+                  const f32 *data,
+                  u64 row_cnt,
+                  u32 col_cnt,
+                  u32 thread_cnt)
+{
+    mho_csv_ctx_t       ctx;
+    FILE                *fptr;
+    u64                 chunk_total;
+    u32                 i;
+    b32                 ret = TRUE;
+
+
+    if (col_cnt == 0)
+        return FALSE;
+
+    chunk_total = (row_cnt + MHO_CSV_CHUNK_ROWS - 1) / MHO_CSV_CHUNK_ROWS;
+    if (thread_cnt == 0)
+        thread_cnt = mho_min(mho__cpu_count(), MHO_READ_MAX_THREADS);
+    thread_cnt = (u32)mho_max(mho_min(thread_cnt, chunk_total), 1);
+
+    fptr = fopen(filename, "wb");
+    if (!fptr)
+    {
+        fprintf(stderr, "Could not open file: %s\n", filename);
+        return FALSE;
+    }
+
+    ctx.data = data;
+    ctx.row_cnt = row_cnt;
+    ctx.col_cnt = col_cnt;
+    ctx.buffers = (char **)calloc(thread_cnt, sizeof(char *));
+    ctx.lens = (usize *)malloc(thread_cnt * sizeof(usize));
+    for (i = 0; ctx.buffers && i < thread_cnt; i++)
+    {
+        ctx.buffers[i] = (char *)malloc((usize)MHO_CSV_CHUNK_ROWS * col_cnt * MHO_CSV_F32_MAX);
+        ret &= (ctx.buffers[i] != NULL);
+    }
+    ret &= (ctx.buffers && ctx.lens);
+
+    // One chunk per thread and round
+    for (ctx.first_chunk = 0; ret && ctx.first_chunk < chunk_total; ctx.first_chunk += thread_cnt)
+    {
+        ctx.chunk_cnt = (u32)mho_min(thread_cnt, chunk_total - ctx.first_chunk);
+        mho__atomic_init(&ctx.next, 0);
+        mho__run_threads(mho__csv_proc, &ctx, ctx.chunk_cnt);
+
+        for (i = 0; ret && i < ctx.chunk_cnt; i++)
+        {
+            if (fwrite(ctx.buffers[i], 1, ctx.lens[i], fptr) != ctx.lens[i])
+            {
+                fprintf(stderr, "Could not write to file: %s\n", filename);
+                ret = FALSE;
+            }
+        }
+    }
+
+    for (i = 0; ctx.buffers && i < thread_cnt; i++)
+        free(ctx.buffers[i]);
+    free(ctx.buffers);
+    free(ctx.lens);
+    if (fclose(fptr) != 0)
+        ret = FALSE;
+
+    return ret;
+}
 
 #pragma warning(default: 4996) // fopen unsafe
 